@@ -0,0 +1,68 @@
+#include "BarrettReducer.h"
+#include "LimbArithmetic.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace BigNumberNamespace {
+
+    BarrettReducer::BarrettReducer(const BigNumber &Modulus) : Modulus(Modulus) {
+        if (Modulus.Negative || Modulus.Limbs.empty()) {
+            throw std::invalid_argument("Invalid modulus: Barrett reduction needs a positive modulus.");
+        }
+        size_t k = Modulus.Limbs.size();
+        std::vector<uint64_t> power(2 * k + 1, 0);
+        power[2 * k] = 1;
+        Mu.resize(k + 2);
+        LimbArithmetic::divide(Mu.data(), nullptr, power.data(), 2 * k + 1, Modulus.Limbs.data(), k);
+        while (!Mu.empty() && Mu.back() == 0) { Mu.pop_back(); }
+    }
+
+    BigNumber::LimbVector BarrettReducer::reduceMagnitude(const uint64_t *x, size_t xn) const {
+        const uint64_t *m = Modulus.Limbs.data();
+        size_t k = Modulus.Limbs.size();
+        if (xn < k) { return {x, x + xn}; }
+
+        // q3 = floor(floor(x / b^(k-1)) * mu / b^(k+1)) underestimates x / m by at most 2.
+        size_t q1n = xn - (k - 1);
+        std::vector<uint64_t> q2(q1n + Mu.size());
+        LimbArithmetic::multiply(q2.data(), x + (k - 1), q1n, Mu.data(), Mu.size());
+        size_t q3n = q2.size() > k + 1 ? q2.size() - (k + 1) : 0;
+
+        // r = (x - q3 * m) mod b^(k+1)
+        size_t width = k + 1;
+        BigNumber::LimbVector r(width, 0);
+        std::copy(x, x + std::min(xn, width), r.begin());
+        if (q3n > 0) {
+            std::vector<uint64_t> q3m(q3n + k);
+            LimbArithmetic::multiply(q3m.data(), q2.data() + (k + 1), q3n, m, k);
+            LimbArithmetic::subtract(r.data(), r.data(), width, q3m.data(), std::min(width, q3m.size()));
+        }
+        while (r[k] != 0 || LimbArithmetic::compare(r.data(), m, k) >= 0) {
+            LimbArithmetic::subtract(r.data(), r.data(), width, m, k);
+        }
+        r.pop_back();
+        return r;
+    }
+
+    BigNumber BarrettReducer::Reduce(const BigNumber &Value) const {
+        if (Value.Limbs.size() > 2 * Modulus.Limbs.size()) {
+            return Value.DivMod(Modulus, DivisionMode::Floored).second;
+        }
+        BigNumber result(false, reduceMagnitude(Value.Limbs.data(), Value.Limbs.size()));
+        if (Value.Negative && !result.Limbs.empty()) { return Modulus - result; }
+        return result;
+    }
+
+    BigNumber BarrettReducer::MulMod(const BigNumber &Left, const BigNumber &Right) const {
+        auto inRange = [this](const BigNumber &Value) { return !Value.Negative && Value < Modulus; };
+        BigNumber left = inRange(Left) ? Left : Reduce(Left);
+        BigNumber right = inRange(Right) ? Right : Reduce(Right);
+        if (left.Limbs.empty() || right.Limbs.empty()) { return {false, {}}; }
+
+        std::vector<uint64_t> product(left.Limbs.size() + right.Limbs.size());
+        LimbArithmetic::multiply(product.data(), left.Limbs.data(), left.Limbs.size(),
+                                 right.Limbs.data(), right.Limbs.size());
+        return {false, reduceMagnitude(product.data(), product.size())};
+    }
+
+} // namespace BigNumberNamespace
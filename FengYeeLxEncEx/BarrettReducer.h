@@ -0,0 +1,39 @@
+// BarrettReducer.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef BARRETTREDUCER_HPP
+#define BARRETTREDUCER_HPP
+
+#include "BigNumber.h"
+#include <cstdint>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    // Barrett reduction by one fixed modulus m of k limbs. The constructor
+    // precomputes mu = floor(2^(128k) / m) once; each reduction then costs two
+    // multiplications and a few subtractions instead of a long division.
+    // All methods are const and nothing changes after construction, so one
+    // reducer can be shared across threads.
+    class BarrettReducer {
+    public:
+        explicit BarrettReducer(const BigNumber &Modulus);
+
+        // Value mod m in [0, m). Values of up to 2k limbs take the Barrett
+        // path; anything larger falls back to long division.
+        [[nodiscard]] BigNumber Reduce(const BigNumber &Value) const;
+
+        // Left * Right mod m in [0, m).
+        [[nodiscard]] BigNumber MulMod(const BigNumber &Left, const BigNumber &Right) const;
+
+    private:
+        BigNumber Modulus;
+        std::vector<uint64_t> Mu;
+
+        [[nodiscard]] BigNumber::LimbVector reduceMagnitude(const uint64_t *x, size_t xn) const;
+
+    };
+
+} // namespace BigNumberNamespace
+
+#endif // BARRETTREDUCER_HPP
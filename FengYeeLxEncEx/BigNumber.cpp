@@ -1,376 +1,750 @@
-#include "BigNumber.h"
-#include <algorithm>
-#include <stdexcept>
-#include <utility>
-#include <sstream>
-#include <vector>
-
-namespace BigNumberNamespace {
-
-    BigNumber::BigNumber(std::string Value) : Value(std::move(Value)) {
-        ValidateInput(this->Value);
-        if (this->Value[0] == '-') {
-            std::string absValue = this->Value.substr(1);
-            absValue = removeLeadingZeros(absValue);
-            if (absValue == "0") { this->Value = "0"; }
-            else { this->Value = "-" + absValue; }
-        } else { this->Value = removeLeadingZeros(this->Value); }
-    }
-
-    void BigNumber::ValidateInput(const std::string &Value) {
-        if (Value.empty()) {
-            throw std::invalid_argument("Invalid input: BigNumber must be initialized with a non-empty string.");
-        }
-        size_t StartIndex = 0;
-        if (Value[0] == '-') {
-            if (Value.size() == 1) {
-                throw std::invalid_argument("Invalid input: Negative sign must be followed by digits.");
-            }
-            StartIndex = 1;
-        }
-        if (Value[StartIndex] == '0' && Value.size() > StartIndex + 1) {
-            throw std::invalid_argument("Invalid input: BigNumber should not contain leading zeros.");
-        }
-        if (!std::all_of(Value.cbegin() + static_cast<std::string::difference_type>(StartIndex), Value.cend(),
-                         ::isdigit)) {
-            throw std::invalid_argument("Invalid input: BigNumber must be initialized with numeric characters only.");
-        }
-    }
-
-    BigNumber BigNumber::operator+(const BigNumber &Other) const {
-        bool isThisNegative = (Value[0] == '-');
-        bool isOtherNegative = (Other.Value[0] == '-');
-
-        std::string absThis = isThisNegative ? Value.substr(1) : Value;
-        std::string absOther = isOtherNegative ? Other.Value.substr(1) : Other.Value;
-
-        std::string result;
-        if (isThisNegative == isOtherNegative) {
-            result = addStrings(absThis, absOther);
-            result = removeLeadingZeros(result);
-            if (isThisNegative) { return BigNumber("-" + result); }
-            else { return BigNumber(result); }
-        } else {
-            int cmp = compareStrings(absThis, absOther);
-            if (cmp >= 0) {
-                result = subtractStrings(absThis, absOther);
-                result = removeLeadingZeros(result);
-                if (result == "0") { return BigNumber("0"); }
-                if (isThisNegative) { return BigNumber("-" + result); }
-                else { return BigNumber(result); }
-            } else {
-                result = subtractStrings(absOther, absThis);
-                result = removeLeadingZeros(result);
-                if (result == "0") { return BigNumber("0"); }
-                if (isOtherNegative) { return BigNumber("-" + result); }
-                else { return BigNumber(result); }
-            }
-        }
-    }
-
-    BigNumber BigNumber::operator-(const BigNumber &Other) const {
-        bool isThisNegative = (Value[0] == '-');
-        bool isOtherNegative = (Other.Value[0] == '-');
-
-        std::string absThis = isThisNegative ? Value.substr(1) : Value;
-        std::string absOther = isOtherNegative ? Other.Value.substr(1) : Other.Value;
-
-        std::string result;
-        if (!isThisNegative && !isOtherNegative) {
-            int cmp = compareStrings(absThis, absOther);
-            if (cmp >= 0) {
-                result = subtractStrings(absThis, absOther);
-                result = removeLeadingZeros(result);
-                return BigNumber(result);
-            } else {
-                result = subtractStrings(absOther, absThis);
-                result = removeLeadingZeros(result);
-                return BigNumber("-" + result);
-            }
-        } else if (isThisNegative && isOtherNegative) {
-            int cmp = compareStrings(absThis, absOther);
-            if (cmp >= 0) {
-                result = subtractStrings(absThis, absOther);
-                result = removeLeadingZeros(result);
-                if (result == "0") { return BigNumber("0"); }
-                return BigNumber("-" + result);
-            } else {
-                result = subtractStrings(absOther, absThis);
-                result = removeLeadingZeros(result);
-                return BigNumber(result);
-            }
-        } else if (isThisNegative) {
-            result = addStrings(absThis, absOther);
-            result = removeLeadingZeros(result);
-            return BigNumber("-" + result);
-        } else {
-            result = addStrings(absThis, absOther);
-            result = removeLeadingZeros(result);
-            return BigNumber(result);
-        }
-    }
-
-    bool BigNumber::operator<(const BigNumber &Other) const {
-        int signThis = (Value[0] == '-') ? -1 : 1;
-        int signOther = (Other.Value[0] == '-') ? -1 : 1;
-
-        std::string absThis = (signThis == -1) ? Value.substr(1) : Value;
-        std::string absOther = (signOther == -1) ? Other.Value.substr(1) : Other.Value;
-
-        absThis = removeLeadingZeros(absThis);
-        absOther = removeLeadingZeros(absOther);
-
-        if (signThis != signOther) { return signThis < signOther; }
-        int cmp = compareStrings(absThis, absOther);
-        if (cmp == 0) { return false; }
-        if (signThis == 1) { return cmp < 0; }
-        else { return cmp > 0; }
-    }
-
-    bool BigNumber::operator>(const BigNumber &Other) const { return Other < *this; }
-
-    bool BigNumber::operator==(const BigNumber &Other) const { return Value == Other.Value; }
-
-    bool BigNumber::operator!=(const BigNumber &Other) const { return !(*this == Other); }
-
-    bool BigNumber::operator<=(const BigNumber &Other) const { return !(*this > Other); }
-
-    bool BigNumber::operator>=(const BigNumber &Other) const { return !(*this < Other); }
-
-    std::string BigNumber::addStrings(const std::string &num1, const std::string &num2) {
-        std::string result;
-        int carry = 0;
-        int i = static_cast<int>(num1.length()) - 1;
-        int j = static_cast<int>(num2.length()) - 1;
-
-        while (i >= 0 || j >= 0 || carry) {
-            int digit1 = (i >= 0) ? num1[i--] - '0' : 0;
-            int digit2 = (j >= 0) ? num2[j--] - '0' : 0;
-            int sum = digit1 + digit2 + carry;
-            carry = sum / 10;
-            result.push_back(static_cast<char>(sum % 10 + '0'));
-        }
-        std::reverse(result.begin(), result.end());
-        return result;
-    }
-
-    std::string BigNumber::subtractStrings(const std::string &num1, const std::string &num2) {
-        std::string result;
-        int borrow = 0;
-        int i = static_cast<int>(num1.length()) - 1;
-        int j = static_cast<int>(num2.length()) - 1;
-
-        while (i >= 0) {
-            int digit1 = num1[i--] - '0' - borrow;
-            int digit2 = (j >= 0) ? num2[j--] - '0' : 0;
-            if (digit1 < digit2) {
-                digit1 += 10;
-                borrow = 1;
-            } else {
-                borrow = 0;
-            }
-            int diff = digit1 - digit2;
-            result.push_back(static_cast<char>(diff + '0'));
-        }
-
-        while (result.length() > 1 && result.back() == '0') { result.pop_back(); }
-        std::reverse(result.begin(), result.end());
-        return result;
-    }
-
-    int BigNumber::compareStrings(const std::string &num1, const std::string &num2) {
-        if (num1.length() > num2.length()) return 1;
-        if (num1.length() < num2.length()) return -1;
-        for (size_t i = 0; i < num1.length(); ++i) {
-            if (num1[i] > num2[i]) return 1;
-            if (num1[i] < num2[i]) return -1;
-        }
-        return 0;
-    }
-
-    std::string BigNumber::removeLeadingZeros(const std::string &num) {
-        size_t pos = num.find_first_not_of('0');
-        if (pos != std::string::npos) {
-            return num.substr(pos);
-        } else {
-            return "0";
-        }
-    }
-
-    std::string BigNumber::ToString() const { return Value; }
-
-    std::string BigNumber::multiplyStringByDigit(const std::string &num, char digit) {
-        if (digit == '0' || num == "0") { return "0"; }
-        int n = digit - '0';
-        std::string result;
-        int carry = 0;
-        for (int i = static_cast<int>(num.length()) - 1; i >= 0; --i) {
-            int prod = (num[i] - '0') * n + carry;
-            carry = prod / 10;
-            result.push_back(static_cast<char>(prod % 10 + '0'));
-        }
-        if (carry) { result.push_back(static_cast<char>(carry + '0')); }
-        std::reverse(result.begin(), result.end());
-        return result;
-    }
-
-    std::string BigNumber::multiplyStrings(const std::string &num1, const std::string &num2) {
-        if (num1 == "0" || num2 == "0") {
-            return "0";
-        }
-        int len1 = static_cast<int>(num1.size());
-        int len2 = static_cast<int>(num2.size());
-        std::vector<int> result(len1 + len2, 0);
-
-        for (int i = len1 - 1; i >= 0; --i) {
-            int n1 = num1[i] - '0';
-            for (int j = len2 - 1; j >= 0; --j) {
-                int n2 = num2[j] - '0';
-                int sum = n1 * n2 + result[i + j + 1];
-                result[i + j + 1] = sum % 10;
-                result[i + j] += sum / 10;
-            }
-        }
-
-        std::string resultStr;
-        for (int i: result) {
-            if (!(resultStr.empty() && i == 0)) {
-                resultStr.push_back(static_cast<char>(i + '0'));
-            }
-        }
-        return resultStr.empty() ? "0" : resultStr;
-    }
-
-    BigNumber BigNumber::operator*(const BigNumber &Other) const {
-        bool isThisNegative = (Value[0] == '-');
-        bool isOtherNegative = (Other.Value[0] == '-');
-
-        std::string absThis = isThisNegative ? Value.substr(1) : Value;
-        std::string absOther = isOtherNegative ? Other.Value.substr(1) : Other.Value;
-
-        if (absThis == "0" || absOther == "0") { return BigNumber("0"); }
-
-        std::string result = multiplyStrings(absThis, absOther);
-        result = removeLeadingZeros(result);
-
-        if (isThisNegative == isOtherNegative) { return BigNumber(result); }
-        else { return BigNumber("-" + result); }
-    }
-
-    std::string BigNumber::divideStrings(const std::string &dividend, const std::string &divisor) {
-        if (divisor == "0") { throw std::invalid_argument("Division by zero"); }
-        if (dividend == "0") { return "0"; }
-        if (compareStrings(dividend, divisor) < 0) { return "0"; }
-
-        std::string quotient;
-        std::string remainder;
-
-        size_t idx = 0;
-        while (idx < dividend.size()) {
-            remainder.push_back(dividend[idx++]);
-            remainder = removeLeadingZeros(remainder);
-
-            if (compareStrings(remainder, divisor) < 0) {
-                quotient.push_back('0');
-                continue;
-            }
-
-            int low = 0, high = 9, count = 0;
-            while (low <= high) {
-                int mid = (low + high) / 2;
-                std::string product = multiplyStringByDigit(divisor, static_cast<char>(mid + '0'));
-                int cmp = compareStrings(product, remainder);
-                if (cmp == 0) {
-                    count = mid;
-                    break;
-                } else if (cmp < 0) {
-                    count = mid;
-                    low = mid + 1;
-                } else { high = mid - 1; }
-            }
-
-            std::string product = multiplyStringByDigit(divisor, static_cast<char>(count + '0'));
-            remainder = subtractStrings(remainder, product);
-            remainder = removeLeadingZeros(remainder);
-
-            quotient.push_back(static_cast<char>(count + '0'));
-        }
-
-        quotient = removeLeadingZeros(quotient);
-        return quotient.empty() ? "0" : quotient;
-    }
-
-    BigNumber BigNumber::operator/(const BigNumber &Other) const {
-        bool isThisNegative = (Value[0] == '-');
-        bool isOtherNegative = (Other.Value[0] == '-');
-
-        std::string absThis = isThisNegative ? Value.substr(1) : Value;
-        std::string absOther = isOtherNegative ? Other.Value.substr(1) : Other.Value;
-
-        if (absOther == "0") { throw std::invalid_argument("Division by zero"); }
-
-        std::string result = divideStrings(absThis, absOther);
-        result = removeLeadingZeros(result);
-
-        if (result == "0") { return BigNumber("0"); }
-
-        if (isThisNegative == isOtherNegative) { return BigNumber(result); }
-        else { return BigNumber("-" + result); }
-    }
-
-    std::string BigNumber::modStrings(const std::string &dividend, const std::string &divisor) {
-        if (divisor == "0") { throw std::invalid_argument("Division by zero"); }
-        if (dividend == "0") { return "0"; }
-        if (compareStrings(dividend, divisor) < 0) { return dividend; }
-
-        std::string remainder;
-        size_t idx = 0;
-        while (idx < dividend.size()) {
-            remainder.push_back(dividend[idx++]);
-            remainder = removeLeadingZeros(remainder);
-
-            if (compareStrings(remainder, divisor) < 0) { continue; }
-
-            int low = 0, high = 9, count = 0;
-            while (low <= high) {
-                int mid = (low + high) / 2;
-                std::string product = multiplyStringByDigit(divisor, static_cast<char>(mid + '0'));
-                int cmp = compareStrings(product, remainder);
-                if (cmp == 0) {
-                    count = mid;
-                    break;
-                } else if (cmp < 0) {
-                    count = mid;
-                    low = mid + 1;
-                } else { high = mid - 1; }
-            }
-
-            std::string product = multiplyStringByDigit(divisor, static_cast<char>(count + '0'));
-            remainder = subtractStrings(remainder, product);
-            remainder = removeLeadingZeros(remainder);
-        }
-
-        remainder = removeLeadingZeros(remainder);
-        return remainder.empty() ? "0" : remainder;
-    }
-
-    BigNumber BigNumber::operator%(const BigNumber &Other) const {
-        bool isThisNegative = (Value[0] == '-');
-        bool isOtherNegative = (Other.Value[0] == '-');
-
-        std::string absThis = isThisNegative ? Value.substr(1) : Value;
-        std::string absOther = isOtherNegative ? Other.Value.substr(1) : Other.Value;
-
-        if (absOther == "0") { throw std::invalid_argument("Division by zero"); }
-
-        std::string result = modStrings(absThis, absOther);
-        result = removeLeadingZeros(result);
-
-        if (result == "0") { return BigNumber("0"); }
-
-        if (isThisNegative) { return BigNumber("-" + result); }
-        else { return BigNumber(result); }
-    }
-
-
-} // namespace BigNumberNamespace
\ No newline at end of file
+#include "BigNumber.h"
+#include "DecimalDigits.h"
+#include "LimbArithmetic.h"
+#include "MontgomeryContext.h"
+#include "Primality.h"
+#include "PrimeGenerator.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    namespace {
+        __extension__ typedef unsigned __int128 uint128_t;
+
+        // 10^19 is the largest power of ten that fits in one 64-bit limb.
+        constexpr uint64_t DecimalChunkBase = 10000000000000000000ULL;
+        constexpr size_t DecimalChunkDigits = 19;
+
+        constexpr uint64_t PowersOfTen[DecimalChunkDigits + 1] = {
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+                100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+                10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+                100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL};
+
+        constexpr uint64_t OneLimb[1] = {1};
+
+        // Radix conversion splits in half down to these sizes and finishes with
+        // the quadratic chunk loops below them.
+        constexpr size_t DecimalSplitDigits = 40 * DecimalChunkDigits;
+        constexpr size_t DecimalSplitLimbs = 40;
+
+        // 10^Digits with Digits = 19 * 2^level. Only formatting divides by the
+        // powers, so their Newton reciprocals are computed on first request.
+        struct DecimalPower {
+            size_t Digits;
+            std::vector<uint64_t> Value;
+            std::vector<uint64_t> Inverse;
+        };
+
+        // Powers are built by repeated squaring on first use and kept for the
+        // life of the process; a deque keeps earlier references valid as it grows.
+        const DecimalPower &decimalPower(size_t level, bool withInverse = false) {
+            static std::mutex mutex;
+            static std::deque<DecimalPower> powers;
+            std::lock_guard<std::mutex> lock(mutex);
+            while (powers.size() <= level) {
+                if (powers.empty()) {
+                    powers.push_back({DecimalChunkDigits, {DecimalChunkBase}, {}});
+                    continue;
+                }
+                const DecimalPower &previous = powers.back();
+                size_t n = previous.Value.size();
+                std::vector<uint64_t> value(2 * n);
+                LimbArithmetic::multiply(value.data(), previous.Value.data(), n, previous.Value.data(), n);
+                if (value.back() == 0) { value.pop_back(); }
+                powers.push_back({2 * previous.Digits, std::move(value), {}});
+            }
+            DecimalPower &power = powers[level];
+            if (withInverse && power.Inverse.empty()) {
+                power.Inverse = LimbArithmetic::reciprocal(power.Value.data(), power.Value.size());
+            }
+            return power;
+        }
+
+        // Magnitudes of at most two limbs take native 128-bit fast paths.
+        bool fitsNative(std::span<const uint64_t> num) { return num.size() <= 2; }
+
+        uint128_t toNative(std::span<const uint64_t> num) {
+            uint128_t value = 0;
+            if (num.size() > 1) { value = static_cast<uint128_t>(num[1]) << 64; }
+            if (!num.empty()) { value |= num[0]; }
+            return value;
+        }
+
+        LimbBuffer fromNative(uint128_t value, uint64_t carry = 0) {
+            LimbBuffer result;
+            if (carry) { result = {static_cast<uint64_t>(value), static_cast<uint64_t>(value >> 64), carry}; }
+            else if (value >> 64) { result = {static_cast<uint64_t>(value), static_cast<uint64_t>(value >> 64)}; }
+            else if (value) { result = {static_cast<uint64_t>(value)}; }
+            return result;
+        }
+
+        // Intermediate for the fused kernels and the compound operators; one
+        // per thread, keeping up to ScratchRetainLimit limbs between calls.
+        LimbBuffer &fusedScratch() {
+            thread_local LimbBuffer scratch;
+            return scratch;
+        }
+
+        // Largest block (in limbs, 32 KiB) the scratch keeps after a call; a
+        // bigger one, left by a single huge product, is freed rather than
+        // pinned for the rest of the thread's life.
+        constexpr size_t ScratchRetainLimit = 4096;
+
+        void trimScratch(LimbBuffer &scratch) {
+            if (scratch.capacity() > ScratchRetainLimit) {
+                scratch.clear();
+                scratch.shrink_to_fit();
+            }
+        }
+
+        // Moves a result computed in the scratch into num. A heap block held
+        // by num goes back to the scratch for the next call; inline limbs are
+        // copied instead, which leaves the scratch inline to allocate afresh.
+        void adoptScratch(LimbBuffer &num, LimbBuffer &scratch) {
+            std::swap(num, scratch);
+            trimScratch(scratch);
+        }
+    }
+
+    BigNumber::BigNumber(std::string Value) {
+        ValidateInput(Value);
+        size_t StartIndex = (Value[0] == '-') ? 1 : 0;
+        Limbs = parseDecimal(Value, StartIndex);
+        Negative = StartIndex == 1 && !Limbs.empty();
+    }
+
+    BigNumber::BigNumber(bool Negative, LimbVector Limbs) : Negative(Negative), Limbs(std::move(Limbs)) {
+        removeLeadingZeros(this->Limbs);
+        if (this->Limbs.empty()) { this->Negative = false; }
+    }
+
+    BigNumber::BigNumber(bool Negative, LimbVector Limbs, NormalizedTag)
+            : Negative(Negative && !Limbs.empty()), Limbs(std::move(Limbs)) {
+        assert(this->Limbs.empty() || this->Limbs.back() != 0);
+    }
+
+    void BigNumber::ValidateInput(const std::string &Value) {
+        if (Value.empty()) {
+            throw std::invalid_argument("Invalid input: BigNumber must be initialized with a non-empty string.");
+        }
+        size_t StartIndex = 0;
+        if (Value[0] == '-') {
+            if (Value.size() == 1) {
+                throw std::invalid_argument("Invalid input: Negative sign must be followed by digits.");
+            }
+            StartIndex = 1;
+        }
+        if (Value[StartIndex] == '0' && Value.size() > StartIndex + 1) {
+            throw std::invalid_argument("Invalid input: BigNumber should not contain leading zeros.");
+        }
+        if (!DecimalDigits::allDigits(Value.data() + StartIndex, Value.size() - StartIndex)) {
+            throw std::invalid_argument("Invalid input: BigNumber must be initialized with numeric characters only.");
+        }
+    }
+
+    BigNumber::LimbVector BigNumber::parseDecimal(const std::string &Value, size_t StartIndex) {
+        LimbVector result = parseDecimalDigits(Value.data() + StartIndex, Value.size() - StartIndex);
+        removeLeadingZeros(result);
+        return result;
+    }
+
+    BigNumber::LimbVector BigNumber::parseDecimalDigits(const char *Digits, size_t Count) {
+        if (Count > DecimalSplitDigits) {
+            // value = high * 10^D + low, with D the largest cached power below Count.
+            size_t level = 0;
+            while (decimalPower(level + 1).Digits < Count) { ++level; }
+            const DecimalPower &power = decimalPower(level);
+            LimbVector high = parseDecimalDigits(Digits, Count - power.Digits);
+            LimbVector low = parseDecimalDigits(Digits + Count - power.Digits, power.Digits);
+            removeLeadingZeros(high);
+            removeLeadingZeros(low);
+            if (high.empty()) { return low; }
+            LimbVector result(high.size() + power.Value.size());
+            LimbArithmetic::multiply(result.data(), high.data(), high.size(), power.Value.data(), power.Value.size());
+            LimbArithmetic::add(result.data(), result.data(), result.size(), low.data(), low.size());
+            return result;
+        }
+
+        LimbVector result;
+        result.reserve(Count / DecimalChunkDigits + 1);
+        size_t idx = 0;
+        // The first chunk takes the odd digits so every later chunk is exactly 19 digits wide.
+        size_t chunkLength = Count % DecimalChunkDigits;
+        if (chunkLength == 0) { chunkLength = DecimalChunkDigits; }
+        while (idx < Count) {
+            multiplyAddSmall(result, PowersOfTen[chunkLength], DecimalDigits::parseChunk(Digits + idx, chunkLength));
+            idx += chunkLength;
+            chunkLength = DecimalChunkDigits;
+        }
+        return result;
+    }
+
+    std::string BigNumber::formatDecimal(MagnitudeView Num) {
+        if (Num.empty()) { return "0"; }
+        // log10(2^64) < 19.27, so this width always fits; the few spare
+        // leading zeros are dropped afterwards.
+        size_t width = Num.size() * 1927 / 100 + 1;
+        std::string result(width, '0');
+        formatDecimalDigits(LimbVector(Num.begin(), Num.end()), result.data(), width);
+        result.erase(0, result.find_first_not_of('0'));
+        return result;
+    }
+
+    void BigNumber::formatDecimalDigits(LimbVector Num, char *Out, size_t Width) {
+        removeLeadingZeros(Num);
+        if (Num.size() > DecimalSplitLimbs) {
+            // Num = high * 10^D + low with 10^D about half as long as Num; the
+            // low half is printed with exactly D digits.
+            size_t level = 0;
+            while (2 * decimalPower(level + 1).Value.size() <= Num.size() + 1) { ++level; }
+            size_t n = decimalPower(level).Value.size();
+            const DecimalPower &power = decimalPower(level, n >= LimbArithmetic::NewtonDivisionThreshold);
+            LimbVector high(Num.size() - n + 1);
+            LimbVector low(n);
+            if (power.Inverse.empty()) {
+                LimbArithmetic::divide(high.data(), low.data(), Num.data(), Num.size(), power.Value.data(), n);
+            } else {
+                LimbArithmetic::divideWithReciprocal(high.data(), low.data(), Num.data(), Num.size(),
+                                                     power.Value.data(), n, power.Inverse);
+            }
+            Num.clear();
+            formatDecimalDigits(std::move(high), Out, Width - power.Digits);
+            formatDecimalDigits(std::move(low), Out + Width - power.Digits, power.Digits);
+            return;
+        }
+
+        // Fill 19-digit chunks from the right; Out already holds '0' padding.
+        size_t position = Width;
+        while (!Num.empty()) {
+            uint64_t chunk = divideBySmall(Num, DecimalChunkBase);
+            for (char *cursor = Out + position; chunk != 0; chunk /= 10) {
+                *--cursor = static_cast<char>('0' + chunk % 10);
+            }
+            position = position > DecimalChunkDigits ? position - DecimalChunkDigits : 0;
+        }
+    }
+
+    BigNumber BigNumber::operator+(const BigNumber &Other) const {
+        if (Negative == Other.Negative) { return {Negative, addMagnitudes(Limbs, Other.Limbs), NormalizedTag{}}; }
+        int cmp = compareMagnitudes(Limbs, Other.Limbs);
+        if (cmp >= 0) { return {Negative, subtractMagnitudes(Limbs, Other.Limbs), NormalizedTag{}}; }
+        else { return {Other.Negative, subtractMagnitudes(Other.Limbs, Limbs), NormalizedTag{}}; }
+    }
+
+    BigNumber BigNumber::operator-(const BigNumber &Other) const {
+        if (Negative != Other.Negative) { return {Negative, addMagnitudes(Limbs, Other.Limbs), NormalizedTag{}}; }
+        int cmp = compareMagnitudes(Limbs, Other.Limbs);
+        if (cmp >= 0) { return {Negative, subtractMagnitudes(Limbs, Other.Limbs), NormalizedTag{}}; }
+        else { return {!Negative, subtractMagnitudes(Other.Limbs, Limbs), NormalizedTag{}}; }
+    }
+
+    void BigNumber::addSigned(MagnitudeView Other, bool OtherNegative) {
+        addSignedMagnitude(Limbs, Negative, Other, OtherNegative);
+    }
+
+    void BigNumber::addSignedMagnitude(LimbVector &Num, bool &Negative, MagnitudeView Other, bool OtherNegative) {
+        if (Other.empty()) { return; }
+        if (Num.empty() || Negative == OtherNegative) {
+            size_t n = std::max(Num.size(), Other.size());
+            Num.resize(n);
+            uint64_t carry = LimbArithmetic::add(Num.data(), Num.data(), n, Other.data(), Other.size());
+            if (carry) { Num.push_back(carry); }
+            Negative = OtherNegative;
+            return;
+        }
+        if (compareMagnitudes(Num, Other) >= 0) {
+            LimbArithmetic::subtract(Num.data(), Num.data(), Num.size(), Other.data(), Other.size());
+        } else {
+            // |Other| > |Num|, so Other is a different array and can be read while Num is rewritten.
+            size_t n = Num.size();
+            Num.resize(Other.size());
+            LimbArithmetic::subtract(Num.data(), Other.data(), Other.size(), Num.data(), n);
+            Negative = OtherNegative;
+        }
+        removeLeadingZeros(Num);
+        if (Num.empty()) { Negative = false; }
+    }
+
+    BigNumber &BigNumber::operator+=(const BigNumber &Other) {
+        addSigned(Other.Limbs, Other.Negative);
+        return *this;
+    }
+
+    BigNumber &BigNumber::operator-=(const BigNumber &Other) {
+        addSigned(Other.Limbs, !Other.Negative && !Other.Limbs.empty());
+        return *this;
+    }
+
+    BigNumber &BigNumber::operator*=(const BigNumber &Other) {
+        if (this == &Other) { return *this = Square(); }
+        bool resultNegative = Negative != Other.Negative;
+        if (Other.Limbs.size() == 1) { multiplyAddSmall(Limbs, Other.Limbs[0], 0); }
+        else {
+            LimbVector &product = fusedScratch();
+            multiplyInto(product, *this, Other);
+            adoptScratch(Limbs, product);
+        }
+        Negative = resultNegative && !Limbs.empty();
+        return *this;
+    }
+
+    BigNumber &BigNumber::operator/=(const BigNumber &Other) {
+        if (Other.Limbs.empty()) { throw std::invalid_argument("Division by zero"); }
+        bool resultNegative = Negative != Other.Negative;
+        if (Other.Limbs.size() == 1 && this != &Other) { divideBySmall(Limbs, Other.Limbs[0]); }
+        else if (compareMagnitudes(Limbs, Other.Limbs) < 0) { Limbs.clear(); }
+        else if (fitsNative(Limbs)) { Limbs = fromNative(toNative(Limbs) / toNative(Other.Limbs)); }
+        else {
+            LimbVector &quotient = fusedScratch();
+            quotient.resize(Limbs.size() - Other.Limbs.size() + 1);
+            LimbArithmetic::divide(quotient.data(), nullptr, Limbs.data(), Limbs.size(), Other.Limbs.data(),
+                                   Other.Limbs.size());
+            removeLeadingZeros(quotient);
+            adoptScratch(Limbs, quotient);
+        }
+        Negative = resultNegative && !Limbs.empty();
+        return *this;
+    }
+
+    BigNumber &BigNumber::operator%=(const BigNumber &Other) {
+        if (Other.Limbs.empty()) { throw std::invalid_argument("Division by zero"); }
+        if (compareMagnitudes(Limbs, Other.Limbs) < 0) { return *this; }
+        if (fitsNative(Limbs)) { Limbs = fromNative(toNative(Limbs) % toNative(Other.Limbs)); }
+        else {
+            LimbVector &remainder = fusedScratch();
+            remainder.resize(Other.Limbs.size());
+            LimbArithmetic::divide(nullptr, remainder.data(), Limbs.data(), Limbs.size(), Other.Limbs.data(),
+                                   Other.Limbs.size());
+            removeLeadingZeros(remainder);
+            adoptScratch(Limbs, remainder);
+        }
+        Negative = Negative && !Limbs.empty();
+        return *this;
+    }
+
+    void BigNumber::addSmall(bool OtherNegative, uint64_t Other) {
+        if (Other == 0) { return; }
+        if (Limbs.empty() || Negative == OtherNegative) {
+            for (uint64_t &limb: Limbs) {
+                limb += Other;
+                Other = limb < Other;
+                if (Other == 0) { break; }
+            }
+            if (Other) { Limbs.push_back(Other); }
+            Negative = OtherNegative;
+            return;
+        }
+        if (Limbs.size() == 1 && Limbs[0] < Other) {
+            Limbs[0] = Other - Limbs[0];
+            Negative = OtherNegative;
+            return;
+        }
+        for (uint64_t &limb: Limbs) {
+            uint64_t before = limb;
+            limb -= Other;
+            Other = before < Other;
+            if (Other == 0) { break; }
+        }
+        removeLeadingZeros(Limbs);
+        if (Limbs.empty()) { Negative = false; }
+    }
+
+    void BigNumber::multiplySmall(bool OtherNegative, uint64_t Other) {
+        if (Other == 0) { Limbs.clear(); }
+        else { multiplyAddSmall(Limbs, Other, 0); }
+        Negative = Negative != OtherNegative && !Limbs.empty();
+    }
+
+    void BigNumber::divideSmall(bool OtherNegative, uint64_t Other) {
+        if (Other == 0) { throw std::invalid_argument("Division by zero"); }
+        divideBySmall(Limbs, Other);
+        Negative = Negative != OtherNegative && !Limbs.empty();
+    }
+
+    BigNumber BigNumber::remainderSmall(uint64_t Other) const {
+        if (Other == 0) { throw std::invalid_argument("Division by zero"); }
+        if (Limbs.empty()) { return {false, LimbVector{}, NormalizedTag{}}; }
+        uint64_t remainder;
+        LimbArithmetic::divide(nullptr, &remainder, Limbs.data(), Limbs.size(), &Other, 1);
+        return {Negative, remainder ? LimbVector{remainder} : LimbVector{}, NormalizedTag{}};
+    }
+
+    int BigNumber::compareSmall(bool OtherNegative, uint64_t Other) const {
+        if (Other == 0) { OtherNegative = false; }
+        if (Negative != OtherNegative) { return Negative ? -1 : 1; }
+        uint64_t low = Limbs.empty() ? 0 : Limbs[0];
+        int cmp = Limbs.size() > 1 ? 1 : (low > Other) - (low < Other);
+        return Negative ? -cmp : cmp;
+    }
+
+    BigNumber operator+(BigNumber &&Left, const BigNumber &Right) { return std::move(Left += Right); }
+
+    BigNumber operator+(const BigNumber &Left, BigNumber &&Right) { return std::move(Right += Left); }
+
+    BigNumber operator+(BigNumber &&Left, BigNumber &&Right) { return std::move(Left += Right); }
+
+    BigNumber operator-(BigNumber &&Left, const BigNumber &Right) { return std::move(Left -= Right); }
+
+    BigNumber operator*(BigNumber &&Left, const BigNumber &Right) { return std::move(Left *= Right); }
+
+    BigNumber operator*(const BigNumber &Left, BigNumber &&Right) { return std::move(Right *= Left); }
+
+    BigNumber operator*(BigNumber &&Left, BigNumber &&Right) { return std::move(Left *= Right); }
+
+    BigNumber operator/(BigNumber &&Left, const BigNumber &Right) { return std::move(Left /= Right); }
+
+    BigNumber operator%(BigNumber &&Left, const BigNumber &Right) { return std::move(Left %= Right); }
+
+    BigNumber BigNumber::Gcd(const BigNumber &Other) const {
+        MagnitudeView larger = Limbs;
+        MagnitudeView smaller = Other.Limbs;
+        if (compareMagnitudes(larger, smaller) < 0) { std::swap(larger, smaller); }
+        std::vector<uint64_t> g = LimbArithmetic::gcd(larger.data(), larger.size(), smaller.data(), smaller.size());
+        return {false, LimbVector(g.begin(), g.end()), NormalizedTag{}};
+    }
+
+    BigNumber BigNumber::Lcm(const BigNumber &Other) const {
+        if (Limbs.empty() || Other.Limbs.empty()) { return {false, LimbVector{}, NormalizedTag{}}; }
+        BigNumber result = Abs() / Gcd(Other);
+        result *= Other.Abs();
+        return result;
+    }
+
+    ExtendedGcdResult BigNumber::ExtendedGcd(const BigNumber &Other) const {
+        BigNumber zero(false, LimbVector{}, NormalizedTag{});
+        if (Other.Limbs.empty()) { return {Abs(), {Negative, LimbVector{1}, NormalizedTag{}}, zero}; }
+        if (Limbs.empty()) { return {Other.Abs(), zero, {Other.Negative, LimbVector{1}, NormalizedTag{}}}; }
+
+        // Track the cofactor of the larger magnitude and recover the other one
+        // from the Bezout identity with a single exact division.
+        bool swapped = compareMagnitudes(Limbs, Other.Limbs) < 0;
+        const BigNumber &larger = swapped ? Other : *this;
+        const BigNumber &smaller = swapped ? *this : Other;
+        std::vector<uint64_t> cofactor;
+        bool cofactorNegative = false;
+        std::vector<uint64_t> g = LimbArithmetic::gcd(larger.Limbs.data(), larger.Limbs.size(), smaller.Limbs.data(),
+                                                      smaller.Limbs.size(), &cofactor, &cofactorNegative);
+        BigNumber gcd(false, LimbVector(g.begin(), g.end()), NormalizedTag{});
+        BigNumber x(cofactorNegative, LimbVector(cofactor.begin(), cofactor.end()), NormalizedTag{});
+        BigNumber y = (gcd - larger.Abs() * x) / smaller.Abs();
+
+        // Coefficients of |larger| and |smaller| become coefficients of the signed inputs.
+        if (larger.Negative) { x.Negate(); }
+        if (smaller.Negative) { y.Negate(); }
+        if (swapped) { std::swap(x, y); }
+        return {std::move(gcd), std::move(x), std::move(y)};
+    }
+
+    std::optional<BigNumber> BigNumber::ModInverse(const BigNumber &Modulus) const {
+        if (Modulus.Negative || Modulus.Limbs.empty()) {
+            throw std::invalid_argument("Invalid modulus: ModInverse needs a positive modulus.");
+        }
+        BigNumber residue = DivMod(Modulus, DivisionMode::Floored).second;
+        if (Modulus == 1) { return residue; }
+        if (residue.Limbs.empty()) { return std::nullopt; }
+
+        const LimbVector &m = Modulus.Limbs;
+        bool powerOfTwo = std::has_single_bit(m.back()) &&
+                          std::all_of(m.begin(), m.end() - 1, [](uint64_t limb) { return limb == 0; });
+        if (powerOfTwo) {
+            if ((residue.Limbs[0] & 1) == 0) { return std::nullopt; }
+            size_t bits = 64 * (m.size() - 1) + static_cast<size_t>(std::countr_zero(m.back()));
+            size_t n = (bits + 63) / 64;
+            LimbVector value(n);
+            LimbVector inverse(n);
+            std::copy(residue.Limbs.begin(), residue.Limbs.begin() + static_cast<std::ptrdiff_t>(
+                    std::min(n, residue.Limbs.size())), value.begin());
+            LimbArithmetic::inverseModPowerOfTwo(inverse.data(), value.data(), n);
+            if (bits % 64) { inverse[n - 1] &= (uint64_t{1} << (bits % 64)) - 1; }
+            return BigNumber(false, std::move(inverse));
+        }
+
+        std::vector<uint64_t> cofactor;
+        bool cofactorNegative = false;
+        std::vector<uint64_t> g = LimbArithmetic::gcd(m.data(), m.size(), residue.Limbs.data(), residue.Limbs.size(),
+                                                      &cofactor, &cofactorNegative, true);
+        if (g.size() != 1 || g[0] != 1) { return std::nullopt; }
+        BigNumber inverse(false, LimbVector(cofactor.begin(), cofactor.end()), NormalizedTag{});
+        if (cofactorNegative) { return Modulus - inverse; }
+        return inverse;
+    }
+
+    bool BigNumber::IsProbablePrime(size_t Rounds) const {
+        if (Negative || Limbs.empty()) { return false; }
+        if (Limbs.size() == 1) { return Primality::isPrime64(Limbs[0]); }
+        if ((Limbs[0] & 1) == 0) { return false; }
+        if (Primality::hasSmallFactor(Magnitude())) { return false; }
+        return Primality::millerRabin(*this, Rounds);
+    }
+
+    BigNumber BigNumber::GeneratePrime(size_t Bits, size_t Threads) { return PrimeGenerator(Bits).Generate(Threads); }
+
+    bool BigNumber::IsNegative() const { return Negative; }
+
+    bool BigNumber::IsZero() const { return Limbs.empty(); }
+
+    std::span<const uint64_t> BigNumber::Magnitude() const { return {Limbs.data(), Limbs.size()}; }
+
+    int BigNumber::CompareMagnitude(const BigNumber &Other) const { return compareMagnitudes(Limbs, Other.Limbs); }
+
+    BigNumber BigNumber::Abs() const & { return {false, Limbs, NormalizedTag{}}; }
+
+    BigNumber BigNumber::Abs() && {
+        Negative = false;
+        return std::move(*this);
+    }
+
+    BigNumber BigNumber::operator-() const & { return {!Negative, Limbs, NormalizedTag{}}; }
+
+    BigNumber BigNumber::operator-() && {
+        Negate();
+        return std::move(*this);
+    }
+
+    void BigNumber::Negate() { Negative = !Negative && !Limbs.empty(); }
+
+    bool BigNumber::operator<(const BigNumber &Other) const {
+        if (Negative != Other.Negative) { return Negative; }
+        int cmp = compareMagnitudes(Limbs, Other.Limbs);
+        if (cmp == 0) { return false; }
+        if (!Negative) { return cmp < 0; }
+        else { return cmp > 0; }
+    }
+
+    bool BigNumber::operator>(const BigNumber &Other) const { return Other < *this; }
+
+    bool BigNumber::operator==(const BigNumber &Other) const {
+        return Negative == Other.Negative && Limbs == Other.Limbs;
+    }
+
+    bool BigNumber::operator!=(const BigNumber &Other) const { return !(*this == Other); }
+
+    bool BigNumber::operator<=(const BigNumber &Other) const { return !(*this > Other); }
+
+    bool BigNumber::operator>=(const BigNumber &Other) const { return !(*this < Other); }
+
+    BigNumber::LimbVector BigNumber::addMagnitudes(MagnitudeView num1, MagnitudeView num2) {
+        if (fitsNative(num1) && fitsNative(num2)) {
+            uint128_t sum = toNative(num1) + toNative(num2);
+            return fromNative(sum, sum < toNative(num1));
+        }
+        if (num1.size() < num2.size()) { std::swap(num1, num2); }
+
+        LimbVector result(num1.size() + 1);
+        result[num1.size()] = LimbArithmetic::add(result.data(), num1.data(), num1.size(), num2.data(), num2.size());
+        removeLeadingZeros(result);
+        return result;
+    }
+
+    BigNumber::LimbVector BigNumber::subtractMagnitudes(MagnitudeView num1, MagnitudeView num2) {
+        if (fitsNative(num1)) { return fromNative(toNative(num1) - toNative(num2)); }
+        LimbVector result(num1.size());
+        LimbArithmetic::subtract(result.data(), num1.data(), num1.size(), num2.data(), num2.size());
+        removeLeadingZeros(result);
+        return result;
+    }
+
+    int BigNumber::compareMagnitudes(MagnitudeView num1, MagnitudeView num2) {
+        if (num1.size() > num2.size()) return 1;
+        if (num1.size() < num2.size()) return -1;
+        return LimbArithmetic::compare(num1.data(), num2.data(), num1.size());
+    }
+
+    void BigNumber::removeLeadingZeros(LimbVector &Num) {
+        while (!Num.empty() && Num.back() == 0) { Num.pop_back(); }
+    }
+
+    std::string BigNumber::ToString() const {
+        std::string result = formatDecimal(Limbs);
+        if (Negative) { result.insert(result.begin(), '-'); }
+        return result;
+    }
+
+    void BigNumber::multiplyAddSmall(LimbVector &num, uint64_t multiplier, uint64_t addend) {
+        uint64_t carry = addend;
+        for (uint64_t &limb: num) {
+            uint128_t prod = static_cast<uint128_t>(limb) * multiplier + carry;
+            limb = static_cast<uint64_t>(prod);
+            carry = static_cast<uint64_t>(prod >> 64);
+        }
+        if (carry) { num.push_back(carry); }
+    }
+
+    uint64_t BigNumber::divideBySmall(LimbVector &num, uint64_t divisor) {
+        uint64_t remainder = LimbArithmetic::divideSingle(num.data(), num.data(), num.size(), divisor);
+        removeLeadingZeros(num);
+        return remainder;
+    }
+
+    BigNumber::LimbVector BigNumber::multiplyMagnitudes(MagnitudeView num1, MagnitudeView num2) {
+        if (num1.empty() || num2.empty()) { return {}; }
+        if (num1.size() == 1 && num2.size() == 1) { return fromNative(static_cast<uint128_t>(num1[0]) * num2[0]); }
+        LimbVector result(num1.size() + num2.size());
+        LimbArithmetic::multiply(result.data(), num1.data(), num1.size(), num2.data(), num2.size());
+        removeLeadingZeros(result);
+        return result;
+    }
+
+    BigNumber BigNumber::operator*(const BigNumber &Other) const {
+        if (this == &Other) { return Square(); }
+        return {Negative != Other.Negative, multiplyMagnitudes(Limbs, Other.Limbs), NormalizedTag{}};
+    }
+
+    BigNumber BigNumber::Square() const {
+        if (Limbs.size() <= 1) {
+            uint128_t value = toNative(Limbs);
+            return {false, fromNative(value * value), NormalizedTag{}};
+        }
+        LimbVector result(2 * Limbs.size());
+        LimbArithmetic::square(result.data(), Limbs.data(), Limbs.size());
+        removeLeadingZeros(result);
+        return {false, std::move(result), NormalizedTag{}};
+    }
+
+    bool BigNumber::multiplyInto(LimbVector &Product, const BigNumber &A, const BigNumber &B) {
+        if (A.Limbs.empty() || B.Limbs.empty()) {
+            Product.clear();
+            return false;
+        }
+        Product.resize(A.Limbs.size() + B.Limbs.size());
+        LimbArithmetic::multiply(Product.data(), A.Limbs.data(), A.Limbs.size(), B.Limbs.data(), B.Limbs.size());
+        removeLeadingZeros(Product);
+        return A.Negative != B.Negative;
+    }
+
+    void BigNumber::remainderInto(BigNumber &Destination, MagnitudeView Value, bool ValueNegative,
+                                  const BigNumber &Modulus) {
+        if (Modulus.Limbs.empty()) { throw std::invalid_argument("Division by zero"); }
+        if (compareMagnitudes(Value, Modulus.Limbs) < 0) {
+            Destination.Limbs.resize(Value.size());
+            std::copy(Value.begin(), Value.end(), Destination.Limbs.begin());
+        } else if (&Destination == &Modulus) {
+            LimbVector remainder(Modulus.Limbs.size());
+            LimbArithmetic::divide(nullptr, remainder.data(), Value.data(), Value.size(), Modulus.Limbs.data(),
+                                   Modulus.Limbs.size());
+            Destination.Limbs = std::move(remainder);
+        } else {
+            Destination.Limbs.resize(Modulus.Limbs.size());
+            LimbArithmetic::divide(nullptr, Destination.Limbs.data(), Value.data(), Value.size(), Modulus.Limbs.data(),
+                                   Modulus.Limbs.size());
+        }
+        removeLeadingZeros(Destination.Limbs);
+        Destination.Negative = ValueNegative && !Destination.Limbs.empty();
+    }
+
+    void BigNumber::MultiplyAdd(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &C) {
+        LimbVector &product = fusedScratch();
+        bool productNegative = multiplyInto(product, A, B);
+        if (&Destination != &C) { Destination = C; }
+        Destination.addSigned(product, productNegative);
+        trimScratch(product);
+    }
+
+    void BigNumber::MultiplyMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B,
+                                const BigNumber &Modulus) {
+        LimbVector &product = fusedScratch();
+        bool productNegative = multiplyInto(product, A, B);
+        remainderInto(Destination, product, productNegative, Modulus);
+        trimScratch(product);
+    }
+
+    void BigNumber::AddMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &Modulus) {
+        LimbVector &sum = fusedScratch();
+        bool sumNegative = A.Negative;
+        sum = A.Limbs;
+        addSignedMagnitude(sum, sumNegative, B.Limbs, B.Negative);
+        remainderInto(Destination, sum, sumNegative, Modulus);
+        trimScratch(sum);
+    }
+
+    void BigNumber::MultiplyAddMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &C,
+                                   const BigNumber &Modulus) {
+        LimbVector &value = fusedScratch();
+        bool valueNegative = multiplyInto(value, A, B);
+        addSignedMagnitude(value, valueNegative, C.Limbs, C.Negative);
+        remainderInto(Destination, value, valueNegative, Modulus);
+        trimScratch(value);
+    }
+
+    void BigNumber::divideMagnitudes(MagnitudeView dividend, MagnitudeView divisor,
+                                     LimbVector *quotient, LimbVector *remainder) {
+        if (divisor.empty()) { throw std::invalid_argument("Division by zero"); }
+        if (compareMagnitudes(dividend, divisor) < 0) {
+            if (quotient) { quotient->clear(); }
+            if (remainder) { *remainder = LimbVector(dividend.begin(), dividend.end()); }
+            return;
+        }
+        if (fitsNative(dividend)) {
+            uint128_t a = toNative(dividend);
+            uint128_t b = toNative(divisor);
+            if (quotient) { *quotient = fromNative(a / b); }
+            if (remainder) { *remainder = fromNative(a % b); }
+            return;
+        }
+
+        LimbVector q(dividend.size() - divisor.size() + 1);
+        LimbVector r(divisor.size());
+        LimbArithmetic::divide(quotient ? q.data() : nullptr, remainder ? r.data() : nullptr,
+                               dividend.data(), dividend.size(), divisor.data(), divisor.size());
+        removeLeadingZeros(q);
+        removeLeadingZeros(r);
+        if (quotient) { *quotient = std::move(q); }
+        if (remainder) { *remainder = std::move(r); }
+    }
+
+    std::pair<BigNumber, BigNumber> BigNumber::DivMod(const BigNumber &Other, DivisionMode Mode) const {
+        if (Other.Limbs.empty()) { throw std::invalid_argument("Division by zero"); }
+
+        LimbVector quotient;
+        LimbVector remainder;
+        divideMagnitudes(Limbs, Other.Limbs, &quotient, &remainder);
+        bool quotientNegative = Negative != Other.Negative;
+
+        if (Mode == DivisionMode::Floored && quotientNegative && !remainder.empty()) {
+            return {BigNumber(true, addMagnitudes(quotient, OneLimb), NormalizedTag{}),
+                    BigNumber(Other.Negative, subtractMagnitudes(Other.Limbs, remainder), NormalizedTag{})};
+        }
+        return {BigNumber(quotientNegative, std::move(quotient), NormalizedTag{}),
+                BigNumber(Negative, std::move(remainder), NormalizedTag{})};
+    }
+
+    BigNumber BigNumber::ModPow(const BigNumber &Exponent, const BigNumber &Modulus) const {
+        if (Modulus.Negative || Modulus.Limbs.empty()) {
+            throw std::invalid_argument("Invalid modulus: ModPow needs a positive modulus.");
+        }
+        if (Exponent.Negative) {
+            throw std::invalid_argument("Invalid exponent: ModPow needs a non-negative exponent.");
+        }
+        if (Modulus.Limbs[0] & 1) { return MontgomeryContext(Modulus).Pow(*this, Exponent); }
+
+        size_t n = Modulus.Limbs.size();
+        LimbVector base = DivMod(Modulus, DivisionMode::Floored).second.Limbs;
+        base.resize(n, 0);
+        LimbVector one(n, 0);
+        divideMagnitudes(OneLimb, Modulus.Limbs, nullptr, &one);
+        one.resize(n, 0);
+
+        LimbVector product(2 * n);
+        LimbVector result = LimbArithmetic::slidingWindowPow(
+                base, Exponent.Limbs.data(), Exponent.Limbs.size(), one,
+                [&](uint64_t *r, const uint64_t *a, const uint64_t *b) {
+                    LimbArithmetic::multiply(product.data(), a, n, b, n);
+                    LimbArithmetic::divide(nullptr, r, product.data(), 2 * n, Modulus.Limbs.data(), n);
+                });
+        return {false, std::move(result)};
+    }
+
+    BigNumber BigNumber::operator/(const BigNumber &Other) const { return DivMod(Other).first; }
+
+    BigNumber BigNumber::operator%(const BigNumber &Other) const { return DivMod(Other).second; }
+
+
+} // namespace BigNumberNamespace
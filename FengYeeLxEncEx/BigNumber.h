@@ -1,64 +1,363 @@
-// BigNumber.h
-// Created by FengYeeLx on 2024-11-02.
-
-#ifndef BIGNUMBER_HPP
-#define BIGNUMBER_HPP
-
-#include <string>
-
-namespace BigNumberNamespace {
-
-    class BigNumber {
-    public:
-        explicit BigNumber(std::string Value);
-
-        BigNumber operator+(const BigNumber &Other) const;
-
-        BigNumber operator-(const BigNumber &Other) const;
-
-        BigNumber operator*(const BigNumber &Other) const;
-
-        BigNumber operator/(const BigNumber &Other) const;
-
-        BigNumber operator%(const BigNumber &Other) const;
-
-        bool operator<(const BigNumber &Other) const;
-
-        bool operator>(const BigNumber &Other) const;
-
-        bool operator==(const BigNumber &Other) const;
-
-        bool operator!=(const BigNumber &Other) const;
-
-        bool operator<=(const BigNumber &Other) const;
-
-        bool operator>=(const BigNumber &Other) const;
-
-        [[nodiscard]] std::string ToString() const;
-
-    private:
-        std::string Value;
-
-        static std::string removeLeadingZeros(const std::string &Num);
-
-        static void ValidateInput(const std::string &Value);
-
-        static std::string addStrings(const std::string &num1, const std::string &num2);
-
-        static std::string subtractStrings(const std::string &num1, const std::string &num2);
-
-        static int compareStrings(const std::string &num1, const std::string &num2);
-
-        static std::string multiplyStringByDigit(const std::string &num, char digit);
-
-        static std::string multiplyStrings(const std::string &num1, const std::string &num2);
-
-        static std::string divideStrings(const std::string &dividend, const std::string &divisor);
-
-        static std::string modStrings(const std::string &dividend, const std::string &divisor);
-
-    };
-
-} // namespace BigNumberNamespace
-
+// BigNumber.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef BIGNUMBER_HPP
+#define BIGNUMBER_HPP
+
+#include "LimbBuffer.h"
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace BigNumberNamespace {
+
+    // Rounding of the quotient in BigNumber::DivMod. Truncated matches the
+    // built-in integer operators (remainder takes the dividend's sign);
+    // Floored rounds toward negative infinity (remainder takes the divisor's sign).
+    enum class DivisionMode {
+        Truncated,
+        Floored
+    };
+
+    // Built-in integers that fit in one limb. Mixed BigNumber/integer operators
+    // take them directly and run single-limb kernels instead of building a
+    // temporary BigNumber.
+    template<typename T>
+    concept NativeInteger = std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t);
+
+    struct ExtendedGcdResult;
+
+    class BigNumber {
+    public:
+        explicit BigNumber(std::string Value);
+
+        // Exact value of a native integer, without a round trip through decimal text.
+        template<NativeInteger T>
+        explicit BigNumber(T Value) : Negative(isNegativeValue(Value)) {
+            if (Value != 0) { Limbs.push_back(magnitudeOf(Value)); }
+        }
+
+        // Construction from and assignment of the lazy expressions in
+        // BigNumberExpression.h, which evaluate straight into this object.
+        template<typename E>
+        requires requires(const E &Expression, BigNumber &Destination) { Expression.EvaluateInto(Destination); }
+        BigNumber(const E &Expression) { Expression.EvaluateInto(*this); }
+
+        template<typename E>
+        requires requires(const E &Expression, BigNumber &Destination) { Expression.EvaluateInto(Destination); }
+        BigNumber &operator=(const E &Expression) {
+            Expression.EvaluateInto(*this);
+            return *this;
+        }
+
+        BigNumber operator+(const BigNumber &Other) const;
+
+        BigNumber operator-(const BigNumber &Other) const;
+
+        BigNumber operator*(const BigNumber &Other) const;
+
+        BigNumber operator/(const BigNumber &Other) const;
+
+        BigNumber operator%(const BigNumber &Other) const;
+
+        // Compound assignment updates this object's limb buffer in place and
+        // reuses its capacity wherever the algorithm allows.
+        BigNumber &operator+=(const BigNumber &Other);
+
+        BigNumber &operator-=(const BigNumber &Other);
+
+        BigNumber &operator*=(const BigNumber &Other);
+
+        BigNumber &operator/=(const BigNumber &Other);
+
+        BigNumber &operator%=(const BigNumber &Other);
+
+        // Overloads for temporaries reuse the temporary's storage for the result.
+        friend BigNumber operator+(BigNumber &&Left, const BigNumber &Right);
+
+        friend BigNumber operator+(const BigNumber &Left, BigNumber &&Right);
+
+        friend BigNumber operator+(BigNumber &&Left, BigNumber &&Right);
+
+        friend BigNumber operator-(BigNumber &&Left, const BigNumber &Right);
+
+        friend BigNumber operator*(BigNumber &&Left, const BigNumber &Right);
+
+        friend BigNumber operator*(const BigNumber &Left, BigNumber &&Right);
+
+        friend BigNumber operator*(BigNumber &&Left, BigNumber &&Right);
+
+        friend BigNumber operator/(BigNumber &&Left, const BigNumber &Right);
+
+        friend BigNumber operator%(BigNumber &&Left, const BigNumber &Right);
+
+        template<NativeInteger T>
+        BigNumber operator+(T Other) const { return BigNumber(*this) += Other; }
+
+        template<NativeInteger T>
+        BigNumber operator-(T Other) const { return BigNumber(*this) -= Other; }
+
+        template<NativeInteger T>
+        BigNumber operator*(T Other) const { return BigNumber(*this) *= Other; }
+
+        template<NativeInteger T>
+        BigNumber operator/(T Other) const { return BigNumber(*this) /= Other; }
+
+        // Remainder with the sign of this, as for the BigNumber overload; the
+        // magnitude comes from one pass over the limbs without copying them.
+        template<NativeInteger T>
+        BigNumber operator%(T Other) const { return remainderSmall(magnitudeOf(Other)); }
+
+        template<NativeInteger T>
+        BigNumber &operator+=(T Other) {
+            addSmall(isNegativeValue(Other), magnitudeOf(Other));
+            return *this;
+        }
+
+        template<NativeInteger T>
+        BigNumber &operator-=(T Other) {
+            addSmall(!isNegativeValue(Other), magnitudeOf(Other));
+            return *this;
+        }
+
+        template<NativeInteger T>
+        BigNumber &operator*=(T Other) {
+            multiplySmall(isNegativeValue(Other), magnitudeOf(Other));
+            return *this;
+        }
+
+        template<NativeInteger T>
+        BigNumber &operator/=(T Other) {
+            divideSmall(isNegativeValue(Other), magnitudeOf(Other));
+            return *this;
+        }
+
+        template<NativeInteger T>
+        BigNumber &operator%=(T Other) { return *this = remainderSmall(magnitudeOf(Other)); }
+
+        template<NativeInteger T>
+        friend BigNumber operator+(BigNumber &&Left, T Right) { return std::move(Left += Right); }
+
+        template<NativeInteger T>
+        friend BigNumber operator-(BigNumber &&Left, T Right) { return std::move(Left -= Right); }
+
+        template<NativeInteger T>
+        friend BigNumber operator*(BigNumber &&Left, T Right) { return std::move(Left *= Right); }
+
+        template<NativeInteger T>
+        friend BigNumber operator/(BigNumber &&Left, T Right) { return std::move(Left /= Right); }
+
+        template<NativeInteger T>
+        friend BigNumber operator+(T Left, const BigNumber &Right) { return Right + Left; }
+
+        template<NativeInteger T>
+        friend BigNumber operator-(T Left, const BigNumber &Right) { return -(Right - Left); }
+
+        template<NativeInteger T>
+        friend BigNumber operator*(T Left, const BigNumber &Right) { return Right * Left; }
+
+        // this * this with dedicated squaring kernels that compute each cross
+        // product once. operator* uses it when both operands are the same object.
+        [[nodiscard]] BigNumber Square() const;
+
+        // Fused forms of A * B + C, A * B % Modulus, (A + B) % Modulus and
+        // (A * B + C) % Modulus, with % truncated as in operator%. The
+        // intermediate stays in a per-thread scratch buffer and the result is
+        // written into Destination's existing storage, so no BigNumber
+        // temporaries are created. The kernels underneath still allocate
+        // working space: every long division by a divisor of two or more limbs
+        // does, and so does multiplication once an operand reaches
+        // KaratsubaThreshold. Destination may be any of the operands.
+        static void MultiplyAdd(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &C);
+
+        static void MultiplyMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B,
+                                const BigNumber &Modulus);
+
+        static void AddMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &Modulus);
+
+        static void MultiplyAddMod(BigNumber &Destination, const BigNumber &A, const BigNumber &B, const BigNumber &C,
+                                   const BigNumber &Modulus);
+
+        // Quotient and remainder from a single long division.
+        [[nodiscard]] std::pair<BigNumber, BigNumber> DivMod(const BigNumber &Other,
+                                                             DivisionMode Mode = DivisionMode::Truncated) const;
+
+        // this^Exponent mod Modulus, in [0, Modulus). Odd moduli use Montgomery
+        // multiplication; even moduli reduce each product by long division.
+        [[nodiscard]] BigNumber ModPow(const BigNumber &Exponent, const BigNumber &Modulus) const;
+
+        // Greatest common divisor of |this| and |Other|; Gcd(0, 0) is 0.
+        [[nodiscard]] BigNumber Gcd(const BigNumber &Other) const;
+
+        // Least common multiple of |this| and |Other|; 0 if either is 0.
+        [[nodiscard]] BigNumber Lcm(const BigNumber &Other) const;
+
+        // Gcd with Bezout coefficients: this * X + Other * Y = Gcd.
+        [[nodiscard]] ExtendedGcdResult ExtendedGcd(const BigNumber &Other) const;
+
+        // this^-1 mod Modulus in [0, Modulus), or std::nullopt when this and
+        // Modulus share a factor. Powers of two use Newton/Hensel lifting;
+        // other moduli use the Lehmer extended GCD.
+        [[nodiscard]] std::optional<BigNumber> ModInverse(const BigNumber &Modulus) const;
+
+        // Miller-Rabin with Rounds bases after trial division by the primes
+        // below 2^15; single-limb values get a deterministic answer. Negative
+        // numbers, 0 and 1 are not prime.
+        [[nodiscard]] bool IsProbablePrime(size_t Rounds = 25) const;
+
+        // Random probable prime of exactly Bits bits, searched on Threads
+        // threads (0 = one per hardware thread). See PrimeGenerator.
+        [[nodiscard]] static BigNumber GeneratePrime(size_t Bits, size_t Threads = 0);
+
+        [[nodiscard]] bool IsNegative() const;
+
+        [[nodiscard]] bool IsZero() const;
+
+        // Read-only view of |this| as little-endian 64-bit limbs, with no leading
+        // zero limbs. The view stays valid until this object is modified.
+        [[nodiscard]] std::span<const uint64_t> Magnitude() const;
+
+        // Three-way comparison of |this| and |Other| without building either.
+        [[nodiscard]] int CompareMagnitude(const BigNumber &Other) const;
+
+        // Sign changes only flip a flag; the rvalue overloads keep the magnitude buffer.
+        [[nodiscard]] BigNumber Abs() const &;
+
+        [[nodiscard]] BigNumber Abs() &&;
+
+        BigNumber operator-() const &;
+
+        BigNumber operator-() &&;
+
+        void Negate();
+
+        bool operator<(const BigNumber &Other) const;
+
+        bool operator>(const BigNumber &Other) const;
+
+        bool operator==(const BigNumber &Other) const;
+
+        bool operator!=(const BigNumber &Other) const;
+
+        bool operator<=(const BigNumber &Other) const;
+
+        bool operator>=(const BigNumber &Other) const;
+
+        // Integer comparisons in either operand order, rewritten from these two.
+        template<NativeInteger T>
+        std::strong_ordering operator<=>(T Other) const {
+            return compareSmall(isNegativeValue(Other), magnitudeOf(Other)) <=> 0;
+        }
+
+        template<NativeInteger T>
+        bool operator==(T Other) const { return compareSmall(isNegativeValue(Other), magnitudeOf(Other)) == 0; }
+
+        [[nodiscard]] std::string ToString() const;
+
+    private:
+        friend class BarrettReducer;
+
+        friend class MontgomeryContext;
+
+        friend class PrimeGenerator;
+
+        using LimbVector = LimbBuffer;
+
+        using MagnitudeView = std::span<const uint64_t>;
+
+        // Sign flag plus little-endian base 2^64 magnitude. Zero is an empty
+        // limb buffer and is never negative; the top limb is never zero.
+        // Magnitudes up to LimbBuffer::InlineCapacity limbs live inside the object.
+        bool Negative = false;
+        LimbVector Limbs;
+
+        // Tag for magnitudes the library produced itself: they are already
+        // trimmed, so the tagged constructor skips normalization entirely.
+        struct NormalizedTag {
+        };
+
+        BigNumber(bool Negative, LimbVector Limbs);
+
+        BigNumber(bool Negative, LimbVector Limbs, NormalizedTag);
+
+        void addSigned(MagnitudeView Other, bool OtherNegative);
+
+        // Num (with sign Negative) += Other (with sign OtherNegative), in place.
+        static void addSignedMagnitude(LimbVector &Num, bool &Negative, MagnitudeView Other, bool OtherNegative);
+
+        // Product = |A * B|, reusing Product's capacity; returns the sign.
+        static bool multiplyInto(LimbVector &Product, const BigNumber &A, const BigNumber &B);
+
+        // Destination = Value % Modulus, truncated, for a Value that is not Destination.
+        static void remainderInto(BigNumber &Destination, MagnitudeView Value, bool ValueNegative,
+                                  const BigNumber &Modulus);
+
+        template<NativeInteger T>
+        static bool isNegativeValue(T Value) {
+            if constexpr (std::signed_integral<T>) { return Value < 0; }
+            else { return false; }
+        }
+
+        // |Value| as an unsigned limb; well defined for the most negative value too.
+        template<NativeInteger T>
+        static uint64_t magnitudeOf(T Value) {
+            uint64_t bits = static_cast<uint64_t>(Value);
+            return isNegativeValue(Value) ? 0 - bits : bits;
+        }
+
+        // Single-limb kernels behind the integer overloads; each is one linear pass.
+        void addSmall(bool OtherNegative, uint64_t Other);
+
+        void multiplySmall(bool OtherNegative, uint64_t Other);
+
+        void divideSmall(bool OtherNegative, uint64_t Other);
+
+        [[nodiscard]] BigNumber remainderSmall(uint64_t Other) const;
+
+        [[nodiscard]] int compareSmall(bool OtherNegative, uint64_t Other) const;
+
+        static void removeLeadingZeros(LimbVector &Num);
+
+        static void ValidateInput(const std::string &Value);
+
+        static LimbVector parseDecimal(const std::string &Value, size_t StartIndex);
+
+        static std::string formatDecimal(MagnitudeView Num);
+
+        // Divide-and-conquer radix conversion over cached powers 10^(19 * 2^k).
+        // formatDecimalDigits writes exactly Width digits into a buffer that
+        // is already filled with '0'.
+        static LimbVector parseDecimalDigits(const char *Digits, size_t Count);
+
+        static void formatDecimalDigits(LimbVector Num, char *Out, size_t Width);
+
+        static LimbVector addMagnitudes(MagnitudeView num1, MagnitudeView num2);
+
+        static LimbVector subtractMagnitudes(MagnitudeView num1, MagnitudeView num2);
+
+        static int compareMagnitudes(MagnitudeView num1, MagnitudeView num2);
+
+        static void multiplyAddSmall(LimbVector &num, uint64_t multiplier, uint64_t addend);
+
+        static uint64_t divideBySmall(LimbVector &num, uint64_t divisor);
+
+        static LimbVector multiplyMagnitudes(MagnitudeView num1, MagnitudeView num2);
+
+        static void divideMagnitudes(MagnitudeView dividend, MagnitudeView divisor,
+                                     LimbVector *quotient, LimbVector *remainder);
+
+    };
+
+    struct ExtendedGcdResult {
+        BigNumber Gcd;
+        BigNumber X;
+        BigNumber Y;
+    };
+
+} // namespace BigNumberNamespace
+
 #endif // BIGNUMBER_HPP
\ No newline at end of file
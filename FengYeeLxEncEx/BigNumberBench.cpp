@@ -0,0 +1,202 @@
+// BigNumberBench.cpp
+// Created by FengYeeLx on 2024-11-02.
+//
+// Times every BigNumber operator across operand sizes and prints the results
+// as JSON. Usage:
+//   bignumber_bench [--seed N] [--max-digits N] [--repeats N] [--warmup N]
+//                   [--budget-ms N] [--square-limbs N] [--output FILE]
+//
+// --square-limbs N adds a sweep of Square() over every operand size from 4 to
+// N limbs, used to place SquareKaratsubaThreshold.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "BigNumber.h"
+
+using namespace BigNumberNamespace;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        uint64_t Seed = 20241102;
+        size_t MaxDigits = 1000000;
+        size_t Repeats = 15;
+        size_t Warmup = 3;
+        // Sampling for one case stops early once it has spent this long, so the
+        // largest sizes finish with fewer (but at least three) samples.
+        double BudgetMs = 3000;
+        size_t SquareLimbs = 0;
+        std::string Output;
+    };
+
+    struct Result {
+        std::string Operation;
+        size_t Digits;
+        size_t Limbs;
+        size_t Iterations;
+        size_t Samples;
+        double MedianNs;
+        double P99Ns;
+    };
+
+    Options parseOptions(int argc, char **argv) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            std::string flag = argv[i];
+            // The value is fetched only once the flag is known, so a trailing unknown flag is reported as such.
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) { throw std::invalid_argument("Missing value for " + flag); }
+                return argv[++i];
+            };
+            if (flag == "--seed") { options.Seed = std::stoull(value()); }
+            else if (flag == "--max-digits") { options.MaxDigits = std::stoull(value()); }
+            else if (flag == "--repeats") { options.Repeats = std::max<size_t>(1, std::stoull(value())); }
+            else if (flag == "--warmup") { options.Warmup = std::stoull(value()); }
+            else if (flag == "--budget-ms") { options.BudgetMs = std::stod(value()); }
+            else if (flag == "--square-limbs") { options.SquareLimbs = std::stoull(value()); }
+            else if (flag == "--output") { options.Output = value(); }
+            else { throw std::invalid_argument("Unknown option " + flag); }
+        }
+        return options;
+    }
+
+    std::string randomDigits(std::mt19937_64 &rng, size_t digits) {
+        std::string text(digits, '0');
+        text[0] = static_cast<char>('1' + rng() % 9);
+        for (size_t i = 1; i < digits; ++i) { text[i] = static_cast<char>('0' + rng() % 10); }
+        return text;
+    }
+
+    // A value of exactly the given number of limbs with random bits and a nonzero top limb.
+    BigNumber randomLimbs(std::mt19937_64 &rng, size_t limbs) {
+        BigNumber value(0);
+        for (size_t i = 0; i < limbs; ++i) {
+            uint64_t limb = rng();
+            if (i == 0 && limb == 0) { limb = 1; }
+            value = value * (uint64_t{1} << 32) * (uint64_t{1} << 32) + limb;
+        }
+        return value;
+    }
+
+    // Keeps results observable so the timed calls cannot be optimized away.
+    volatile size_t Sink = 0;
+
+    // Calibrates a batch size that takes about a millisecond, runs the warmup
+    // batches, then records ns/op for each timed batch.
+    Result measure(const std::string &operation, size_t digits, size_t limbs, const Options &options,
+                   const std::function<size_t()> &body) {
+        auto elapsedNs = [](Clock::time_point start) {
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        };
+
+        size_t iterations = 1;
+        for (;;) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) { Sink = Sink + body(); }
+            if (elapsedNs(start) >= 1e6 || iterations >= (size_t{1} << 24)) { break; }
+            iterations *= 2;
+        }
+        for (size_t w = 0; w < options.Warmup; ++w) {
+            for (size_t i = 0; i < iterations; ++i) { Sink = Sink + body(); }
+        }
+
+        std::vector<double> samples;
+        auto caseStart = Clock::now();
+        while (samples.size() < options.Repeats) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) { Sink = Sink + body(); }
+            samples.push_back(elapsedNs(start) / static_cast<double>(iterations));
+            if (samples.size() >= 3 && elapsedNs(caseStart) >= options.BudgetMs * 1e6) { break; }
+        }
+
+        std::sort(samples.begin(), samples.end());
+        size_t n = samples.size();
+        double median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+        // Nearest-rank percentile.
+        size_t rank = (99 * n + 99) / 100;
+        return {operation, digits, limbs, iterations, n, median, samples[std::max<size_t>(rank, 1) - 1]};
+    }
+
+    void writeJson(std::ostream &out, const Options &options, const std::vector<Result> &results) {
+        out << "{\n";
+        out << "  \"seed\": " << options.Seed << ",\n";
+        out << "  \"repeats\": " << options.Repeats << ",\n";
+        out << "  \"warmup\": " << options.Warmup << ",\n";
+        out << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            out << "    {\"operation\": \"" << r.Operation << "\", \"digits\": " << r.Digits
+                << ", \"limbs\": " << r.Limbs << ", \"iterations\": " << r.Iterations << ", \"samples\": " << r.Samples
+                << ", \"median_ns\": " << r.MedianNs << ", \"p99_ns\": " << r.P99Ns << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    try {
+        Options options = parseOptions(argc, argv);
+        std::mt19937_64 rng(options.Seed);
+        std::vector<Result> results;
+
+        for (size_t digits = 1; digits <= options.MaxDigits; digits *= 10) {
+            // Same-size operands for + - * and comparisons; a dividend twice as
+            // long as the divisor so / and % produce a full-size quotient.
+            std::string leftText = randomDigits(rng, digits);
+            std::string rightText = randomDigits(rng, digits);
+            BigNumber left(leftText);
+            BigNumber right(rightText);
+            BigNumber negativeRight("-" + rightText);
+            BigNumber dividend(randomDigits(rng, 2 * digits));
+            BigNumber equalCopy = left;
+
+            auto run = [&](const std::string &operation, const std::function<size_t()> &body) {
+                results.push_back(measure(operation, digits, left.Magnitude().size(), options, body));
+                std::cerr << operation << " " << digits << " digits: " << results.back().MedianNs << " ns/op\n";
+            };
+
+            run("add", [&] { return (left + right).Magnitude().size(); });
+            run("add_mixed_sign", [&] { return (left + negativeRight).Magnitude().size(); });
+            run("subtract", [&] { return (left - right).Magnitude().size(); });
+            run("multiply", [&] { return (left * right).Magnitude().size(); });
+            run("square", [&] { return left.Square().Magnitude().size(); });
+            run("divide", [&] { return (dividend / right).Magnitude().size(); });
+            run("modulo", [&] { return (dividend % right).Magnitude().size(); });
+            run("add_native", [&] { return (left + 1).Magnitude().size(); });
+            run("multiply_native", [&] { return (left * 3).Magnitude().size(); });
+            run("modulo_native", [&] { return (left % 97).Magnitude().size(); });
+            run("less", [&] { return static_cast<size_t>(left < right); });
+            run("equal", [&] { return static_cast<size_t>(left == equalCopy); });
+            run("construct", [&] { return BigNumber(leftText).Magnitude().size(); });
+            run("to_string", [&] { return left.ToString().size(); });
+        }
+
+        for (size_t limbs = 4; limbs <= options.SquareLimbs; ++limbs) {
+            BigNumber value = randomLimbs(rng, limbs);
+            results.push_back(measure("square_sweep", value.ToString().size(), limbs, options,
+                                      [&] { return value.Square().Magnitude().size(); }));
+            std::cerr << "square_sweep " << limbs << " limbs: " << results.back().MedianNs << " ns/op\n";
+        }
+
+        if (options.Output.empty()) { writeJson(std::cout, options, results); }
+        else {
+            std::ofstream file(options.Output);
+            if (!file) { throw std::runtime_error("Cannot open " + options.Output); }
+            writeJson(file, options, results);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+// BigNumberExpression.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef BIGNUMBEREXPRESSION_HPP
+#define BIGNUMBEREXPRESSION_HPP
+
+#include "BigNumber.h"
+#include <concepts>
+#include <type_traits>
+
+// Opt-in lazy evaluation for BigNumber arithmetic. Lazy(a) starts an
+// expression; +, * and % on it build a tree of nodes instead of computing,
+// and the tree is evaluated when it is assigned to or converted into a
+// BigNumber. These shapes are recognized at compile time and lowered to the
+// fused kernels, which write into the destination's storage:
+//
+//   Lazy(a) * b + c        -> BigNumber::MultiplyAdd
+//   Lazy(a) * b % m        -> BigNumber::MultiplyMod
+//   (Lazy(a) + b) % m      -> BigNumber::AddMod
+//   (Lazy(a) * b + c) % m  -> BigNumber::MultiplyAddMod
+//
+// Other shapes fall back to the eager operators. Nodes refer to their
+// BigNumber operands, so an expression must be evaluated while those are
+// alive; it is meant to be consumed in the statement that builds it.
+namespace BigNumberNamespace {
+
+    template<typename T>
+    struct IsExpressionNode : std::false_type {
+    };
+
+    template<typename T>
+    concept ExpressionNode = IsExpressionNode<T>::value;
+
+    template<typename T>
+    concept ExpressionOperand = ExpressionNode<T> || std::same_as<T, BigNumber>;
+
+    // BigNumber operands are held by reference, nested nodes by value.
+    template<typename T>
+    using OperandStorage = std::conditional_t<std::same_as<T, BigNumber>, const BigNumber &, T>;
+
+    struct LazyTerm {
+        const BigNumber &Value;
+
+        void EvaluateInto(BigNumber &Destination) const {
+            if (&Destination != &Value) { Destination = Value; }
+        }
+    };
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    struct SumExpression {
+        OperandStorage<L> Left;
+        OperandStorage<R> Right;
+
+        void EvaluateInto(BigNumber &Destination) const;
+    };
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    struct ProductExpression {
+        OperandStorage<L> Left;
+        OperandStorage<R> Right;
+
+        void EvaluateInto(BigNumber &Destination) const;
+    };
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    struct ModuloExpression {
+        OperandStorage<L> Left;
+        OperandStorage<R> Right;
+
+        void EvaluateInto(BigNumber &Destination) const;
+    };
+
+    template<>
+    struct IsExpressionNode<LazyTerm> : std::true_type {
+    };
+
+    template<typename L, typename R>
+    struct IsExpressionNode<SumExpression<L, R>> : std::true_type {
+    };
+
+    template<typename L, typename R>
+    struct IsExpressionNode<ProductExpression<L, R>> : std::true_type {
+    };
+
+    template<typename L, typename R>
+    struct IsExpressionNode<ModuloExpression<L, R>> : std::true_type {
+    };
+
+    template<typename T>
+    struct IsProduct : std::false_type {
+    };
+
+    template<typename L, typename R>
+    struct IsProduct<ProductExpression<L, R>> : std::true_type {
+    };
+
+    template<typename T>
+    struct IsSum : std::false_type {
+    };
+
+    template<typename L, typename R>
+    struct IsSum<SumExpression<L, R>> : std::true_type {
+    };
+
+    inline LazyTerm Lazy(const BigNumber &Value) { return {Value}; }
+
+    // The operand as a BigNumber: a reference for leaves, an evaluated
+    // temporary for nested nodes.
+    template<ExpressionOperand T>
+    decltype(auto) evaluateOperand(const T &Operand) {
+        if constexpr (std::same_as<T, BigNumber>) { return Operand; }
+        else if constexpr (std::same_as<T, LazyTerm>) { return Operand.Value; }
+        else { return BigNumber(Operand); }
+    }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    void SumExpression<L, R>::EvaluateInto(BigNumber &Destination) const {
+        if constexpr (IsProduct<L>::value) {
+            BigNumber::MultiplyAdd(Destination, evaluateOperand(Left.Left), evaluateOperand(Left.Right),
+                                   evaluateOperand(Right));
+        } else if constexpr (IsProduct<R>::value) {
+            BigNumber::MultiplyAdd(Destination, evaluateOperand(Right.Left), evaluateOperand(Right.Right),
+                                   evaluateOperand(Left));
+        } else {
+            decltype(auto) left = evaluateOperand(Left);
+            decltype(auto) right = evaluateOperand(Right);
+            if (&Destination == &right) { Destination += left; }
+            else {
+                if (&Destination != &left) { Destination = left; }
+                Destination += right;
+            }
+        }
+    }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    void ProductExpression<L, R>::EvaluateInto(BigNumber &Destination) const {
+        Destination = evaluateOperand(Left) * evaluateOperand(Right);
+    }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    void ModuloExpression<L, R>::EvaluateInto(BigNumber &Destination) const {
+        if constexpr (IsSum<L>::value) {
+            using SumLeft = std::remove_cvref_t<decltype(Left.Left)>;
+            using SumRight = std::remove_cvref_t<decltype(Left.Right)>;
+            if constexpr (IsProduct<SumLeft>::value) {
+                BigNumber::MultiplyAddMod(Destination, evaluateOperand(Left.Left.Left),
+                                          evaluateOperand(Left.Left.Right), evaluateOperand(Left.Right),
+                                          evaluateOperand(Right));
+            } else if constexpr (IsProduct<SumRight>::value) {
+                BigNumber::MultiplyAddMod(Destination, evaluateOperand(Left.Right.Left),
+                                          evaluateOperand(Left.Right.Right), evaluateOperand(Left.Left),
+                                          evaluateOperand(Right));
+            } else {
+                BigNumber::AddMod(Destination, evaluateOperand(Left.Left), evaluateOperand(Left.Right),
+                                  evaluateOperand(Right));
+            }
+        } else if constexpr (IsProduct<L>::value) {
+            BigNumber::MultiplyMod(Destination, evaluateOperand(Left.Left), evaluateOperand(Left.Right),
+                                   evaluateOperand(Right));
+        } else {
+            Destination = evaluateOperand(Left) % evaluateOperand(Right);
+        }
+    }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    requires (ExpressionNode<L> || ExpressionNode<R>)
+    SumExpression<L, R> operator+(const L &Left, const R &Right) { return {Left, Right}; }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    requires (ExpressionNode<L> || ExpressionNode<R>)
+    ProductExpression<L, R> operator*(const L &Left, const R &Right) { return {Left, Right}; }
+
+    template<ExpressionOperand L, ExpressionOperand R>
+    requires (ExpressionNode<L> || ExpressionNode<R>)
+    ModuloExpression<L, R> operator%(const L &Left, const R &Right) { return {Left, Right}; }
+
+} // namespace BigNumberNamespace
+
+#endif // BIGNUMBEREXPRESSION_HPP
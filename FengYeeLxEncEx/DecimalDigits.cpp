@@ -0,0 +1,131 @@
+#include "DecimalDigits.h"
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace BigNumberNamespace::DecimalDigits {
+
+    namespace {
+        constexpr bool LittleEndian = std::endian::native == std::endian::little;
+
+        constexpr uint64_t RepeatedByte(uint8_t value) { return 0x0101010101010101ULL * value; }
+
+        uint64_t load64(const char *text) {
+            uint64_t word;
+            std::memcpy(&word, text, sizeof(word));
+            return word;
+        }
+
+        // Every byte is 0x30..0x39: the high nibble must be 3, and adding 6
+        // to the byte must not carry out of the low nibble.
+        bool eightDigits(uint64_t word) {
+            return ((word & RepeatedByte(0xF0)) |
+                    (((word + RepeatedByte(0x06)) & RepeatedByte(0xF0)) >> 4)) == RepeatedByte(0x33);
+        }
+
+        // Eight digits in memory order, first digit in the lowest byte. Pairs,
+        // then quads, are combined with one multiply each.
+        uint32_t parseEightDigits(uint64_t word) {
+            word -= RepeatedByte('0');
+            word = (word * 10) + (word >> 8);
+            word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                    (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+            return static_cast<uint32_t>(word);
+        }
+
+#if defined(__SSE2__)
+        bool sixteenDigits(__m128i chars) {
+            __m128i below = _mm_cmplt_epi8(chars, _mm_set1_epi8('0'));
+            __m128i above = _mm_cmpgt_epi8(chars, _mm_set1_epi8('9'));
+            return _mm_movemask_epi8(_mm_or_si128(below, above)) == 0;
+        }
+
+        // Sixteen digits: widen to 16-bit lanes, then fold neighbours with
+        // multiply-adds by (10, 1), (100, 1) and (10000, 1).
+        uint64_t parseSixteenDigits(const char *text) {
+            __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text)),
+                                          _mm_set1_epi8('0'));
+            __m128i zero = _mm_setzero_si128();
+            __m128i tens = _mm_set1_epi32(0x0001000A);
+            __m128i pairs = _mm_packs_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(digits, zero), tens),
+                                            _mm_madd_epi16(_mm_unpackhi_epi8(digits, zero), tens));
+            __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010064));
+            __m128i octets = _mm_madd_epi16(_mm_packs_epi32(quads, quads), _mm_set1_epi32(0x00012710));
+            uint64_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(octets));
+            uint64_t low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(octets, 4)));
+            return high * 100000000ULL + low;
+        }
+#endif
+
+        bool allDigitsPortable(const char *text, size_t n) {
+            size_t i = 0;
+#if defined(__SSE2__)
+            for (; i + 16 <= n; i += 16) {
+                if (!sixteenDigits(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i)))) { return false; }
+            }
+#endif
+            if constexpr (LittleEndian) {
+                for (; i + 8 <= n; i += 8) {
+                    if (!eightDigits(load64(text + i))) { return false; }
+                }
+            }
+            for (; i < n; ++i) {
+                if (text[i] < '0' || text[i] > '9') { return false; }
+            }
+            return true;
+        }
+
+#if defined(__x86_64__)
+        // 32 characters per step; the remainder goes through the portable path.
+        __attribute__((target("avx2")))
+        bool allDigitsAvx2(const char *text, size_t n) {
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+                __m256i below = _mm256_cmpgt_epi8(_mm256_set1_epi8('0'), chars);
+                __m256i above = _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9'));
+                if (_mm256_movemask_epi8(_mm256_or_si256(below, above)) != 0) { return false; }
+            }
+            return allDigitsPortable(text + i, n - i);
+        }
+#endif
+
+        using DigitCheck = bool (*)(const char *text, size_t n);
+
+        // Chosen once from the running CPU, as for the carry kernels in
+        // LimbArithmetic.cpp.
+        DigitCheck digitCheck() {
+            static const DigitCheck check = []() -> DigitCheck {
+#if defined(__x86_64__)
+                if (__builtin_cpu_supports("avx2")) { return allDigitsAvx2; }
+#endif
+                return allDigitsPortable;
+            }();
+            return check;
+        }
+    }
+
+    bool allDigits(const char *text, size_t n) {
+        return n >= 32 ? digitCheck()(text, n) : allDigitsPortable(text, n);
+    }
+
+    uint64_t parseChunk(const char *text, size_t n) {
+        uint64_t value = 0;
+        size_t i = 0;
+        if constexpr (LittleEndian) {
+            // Leading odd digits one at a time, so the rest splits into whole blocks.
+            for (size_t head = n % 8; i < head; ++i) { value = value * 10 + static_cast<uint64_t>(text[i] - '0'); }
+#if defined(__SSE2__)
+            if (n - i == 16) { return value * 10000000000000000ULL + parseSixteenDigits(text + i); }
+#endif
+            for (; i < n; i += 8) { value = value * 100000000ULL + parseEightDigits(load64(text + i)); }
+            return value;
+        }
+        for (; i < n; ++i) { value = value * 10 + static_cast<uint64_t>(text[i] - '0'); }
+        return value;
+    }
+
+} // namespace BigNumberNamespace::DecimalDigits
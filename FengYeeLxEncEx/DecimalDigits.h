@@ -0,0 +1,25 @@
+// DecimalDigits.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef DECIMALDIGITS_HPP
+#define DECIMALDIGITS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Word-at-a-time kernels for ASCII decimal text. SSE2 handles 16 characters
+// per step, and validation switches to 32 with AVX2 when the running CPU has
+// it; other targets use 8-byte SWAR on little-endian machines and a scalar
+// loop otherwise.
+namespace BigNumberNamespace::DecimalDigits {
+
+    // True if every character in text[0..n) is '0'..'9'.
+    bool allDigits(const char *text, size_t n);
+
+    // Value of the n <= 19 decimal digits in text[0..n), which must already
+    // be validated.
+    uint64_t parseChunk(const char *text, size_t n);
+
+} // namespace BigNumberNamespace::DecimalDigits
+
+#endif // DECIMALDIGITS_HPP
@@ -0,0 +1,84 @@
+#include "FixedBaseExp.h"
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <stdexcept>
+
+namespace BigNumberNamespace {
+
+    FixedBaseExp::FixedBaseExp(const BigNumber &Base, const BigNumber &Modulus, size_t MaxExponentBits, size_t Teeth,
+                               size_t RequestedTables)
+            : Base(Base), Modulus(Modulus), Context(Modulus), MaxExponentBits(std::max<size_t>(MaxExponentBits, 1)),
+              Teeth(Teeth), Tables(RequestedTables) {
+        if (Teeth < 1 || Teeth > 16 || RequestedTables < 1) {
+            throw std::invalid_argument("Invalid comb: FixedBaseExp needs 1 to 16 teeth and at least one table.");
+        }
+        RowBits = (this->MaxExponentBits + Teeth - 1) / Teeth;
+        BlockBits = (RowBits + Tables - 1) / Tables;
+        // Rounding can leave trailing tables with no bits to cover.
+        Tables = (RowBits + BlockBits - 1) / BlockBits;
+
+        size_t n = Context.LimbCount();
+        size_t entries = size_t{1} << Teeth;
+        std::vector<uint64_t> scratch(n + 2);
+        Table.assign(Tables * entries * n, 0);
+
+        // power walks Base^(2^k) for k = 0, 1, ...; table s takes the powers at
+        // k = i * RowBits + s * BlockBits as its generators.
+        std::vector<uint64_t> power = Context.ToMontgomery(Base);
+        std::vector<std::vector<uint64_t>> generators(Tables * Teeth);
+        for (size_t k = 0; k < Teeth * RowBits; ++k) {
+            size_t row = k / RowBits;
+            size_t offset = k % RowBits;
+            if (offset % BlockBits == 0) { generators[offset / BlockBits * Teeth + row] = power; }
+            Context.Multiply(power.data(), power.data(), power.data(), scratch.data());
+        }
+
+        std::vector<uint64_t> one = Context.One();
+        for (size_t s = 0; s < Tables; ++s) {
+            uint64_t *table = Table.data() + s * entries * n;
+            std::copy(one.begin(), one.end(), table);
+            for (size_t j = 1; j < entries; ++j) {
+                // Entry j extends entry j without its top bit by that bit's generator.
+                size_t top = std::bit_width(j) - 1;
+                const std::vector<uint64_t> &generator = generators[s * Teeth + top];
+                Context.Multiply(table + j * n, table + (j ^ (size_t{1} << top)) * n, generator.data(),
+                                 scratch.data());
+            }
+        }
+    }
+
+    BigNumber FixedBaseExp::Pow(const BigNumber &Exponent) const {
+        if (Exponent.IsNegative()) {
+            throw std::invalid_argument("Invalid exponent: ModPow needs a non-negative exponent.");
+        }
+        std::span<const uint64_t> exponent = Exponent.Magnitude();
+        if (exponent.size() > (MaxExponentBits + 63) / 64 ||
+            (!exponent.empty() && 64 * exponent.size() - std::countl_zero(exponent.back()) > MaxExponentBits)) {
+            return Base.ModPow(Exponent, Modulus);
+        }
+        auto bitAt = [exponent](size_t i) -> size_t {
+            return i / 64 < exponent.size() ? (exponent[i / 64] >> (i % 64)) & 1 : 0;
+        };
+
+        size_t n = Context.LimbCount();
+        size_t entries = size_t{1} << Teeth;
+        std::vector<uint64_t> scratch(n + 2);
+        std::vector<uint64_t> result = Context.One();
+        for (size_t k = BlockBits; k-- > 0;) {
+            if (k + 1 < BlockBits) { Context.Multiply(result.data(), result.data(), result.data(), scratch.data()); }
+            for (size_t s = 0; s < Tables; ++s) {
+                size_t offset = s * BlockBits + k;
+                if (offset >= RowBits) { continue; }
+                size_t index = 0;
+                for (size_t i = 0; i < Teeth; ++i) { index |= bitAt(i * RowBits + offset) << i; }
+                if (index) {
+                    Context.Multiply(result.data(), result.data(), Table.data() + (s * entries + index) * n,
+                                     scratch.data());
+                }
+            }
+        }
+        return Context.FromMontgomery(result);
+    }
+
+} // namespace BigNumberNamespace
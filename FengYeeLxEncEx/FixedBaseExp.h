@@ -0,0 +1,52 @@
+// FixedBaseExp.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef FIXEDBASEEXP_HPP
+#define FIXEDBASEEXP_HPP
+
+#include "BigNumber.h"
+#include "MontgomeryContext.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    // Base^e mod m for one fixed base and odd modulus, using a Lim-Lee comb.
+    // An exponent of up to MaxExponentBits bits is read as Teeth rows of
+    // a = ceil(MaxExponentBits / Teeth) bits, and each row is split into Tables
+    // blocks of b = ceil(a / Tables) bits. Table s holds all 2^Teeth products
+    // of Base^(2^(i*a + s*b)), so one power costs b - 1 squarings and about
+    // a multiplications. Memory is Tables * 2^Teeth residues. More teeth make
+    // each power cheaper at twice the memory per extra tooth; more tables
+    // trade memory for fewer squarings. Immutable after construction, so one
+    // object can be shared across threads.
+    class FixedBaseExp {
+    public:
+        // Throws std::invalid_argument for an even or non-positive modulus, or
+        // when Teeth is outside [1, 16] or RequestedTables is 0. Rounding may
+        // leave fewer tables than requested.
+        FixedBaseExp(const BigNumber &Base, const BigNumber &Modulus, size_t MaxExponentBits, size_t Teeth = 8,
+                     size_t RequestedTables = 2);
+
+        // Base^Exponent mod Modulus in [0, Modulus). Exponents longer than
+        // MaxExponentBits fall back to BigNumber::ModPow.
+        [[nodiscard]] BigNumber Pow(const BigNumber &Exponent) const;
+
+    private:
+        BigNumber Base;
+        BigNumber Modulus;
+        MontgomeryContext Context;
+        size_t MaxExponentBits;
+        size_t Teeth;
+        size_t Tables;
+        size_t RowBits;
+        size_t BlockBits;
+        // Tables * 2^Teeth residues of LimbCount() limbs each, table-major.
+        std::vector<uint64_t> Table;
+
+    };
+
+} // namespace BigNumberNamespace
+
+#endif // FIXEDBASEEXP_HPP
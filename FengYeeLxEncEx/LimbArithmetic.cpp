@@ -0,0 +1,1128 @@
+#include "LimbArithmetic.h"
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace BigNumberNamespace::LimbArithmetic {
+
+    namespace {
+        __extension__ typedef unsigned __int128 uint128_t;
+
+        // Multiplicative inverse of 3 modulo 2^64, used for exact division.
+        constexpr uint64_t InverseOfThree = 0xAAAAAAAAAAAAAAABULL;
+
+        // r[0..rn) += a[0..an) with an <= rn; returns the carry out of r.
+        uint64_t addInto(uint64_t *r, size_t rn, const uint64_t *a, size_t an) {
+            uint64_t carry = add(r, r, an, a, an);
+            for (size_t i = an; carry && i < rn; ++i) { carry = (++r[i] == 0); }
+            return carry;
+        }
+
+        // r[0..rn) -= a[0..an) with an <= rn; returns the borrow out of r.
+        uint64_t subtractFrom(uint64_t *r, size_t rn, const uint64_t *a, size_t an) {
+            uint64_t borrow = subtract(r, r, an, a, an);
+            for (size_t i = an; borrow && i < rn; ++i) { borrow = (r[i]-- == 0); }
+            return borrow;
+        }
+
+        void copyPadded(uint64_t *dst, size_t dn, const uint64_t *src, size_t sn) {
+            std::copy(src, src + sn, dst);
+            std::fill(dst + sn, dst + dn, 0);
+        }
+
+        // Helpers for fixed-width two's complement values used by Toom-3 interpolation.
+        bool isNegative(const uint64_t *r, size_t n) { return (r[n - 1] >> 63) != 0; }
+
+        void negate(uint64_t *r, size_t n) {
+            uint64_t carry = 1;
+            for (size_t i = 0; i < n; ++i) {
+                uint128_t sum = static_cast<uint128_t>(~r[i]) + carry;
+                r[i] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+        }
+
+        void shiftLeftOne(uint64_t *r, size_t n) {
+            for (size_t i = n; i-- > 1;) { r[i] = (r[i] << 1) | (r[i - 1] >> 63); }
+            r[0] <<= 1;
+        }
+
+        void shiftRightOneSigned(uint64_t *r, size_t n) {
+            for (size_t i = 0; i + 1 < n; ++i) { r[i] = (r[i] >> 1) | (r[i + 1] << 63); }
+            r[n - 1] = static_cast<uint64_t>(static_cast<int64_t>(r[n - 1]) >> 1);
+        }
+
+        // Divides by 3 modulo 2^(64n); exact whenever the value is a multiple of 3.
+        void divideExactByThree(uint64_t *r, size_t n) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint64_t limb = r[i] - carry;
+                uint64_t borrow = r[i] < carry;
+                uint64_t q = limb * InverseOfThree;
+                r[i] = q;
+                carry = static_cast<uint64_t>((static_cast<uint128_t>(q) * 3) >> 64) + borrow;
+            }
+        }
+
+        // r = |x - y| with xn >= yn, r has xn limbs; returns true when x < y.
+        bool absoluteDifference(uint64_t *r, const uint64_t *x, size_t xn, const uint64_t *y, size_t yn) {
+            bool xHigher = std::any_of(x + yn, x + xn, [](uint64_t limb) { return limb != 0; });
+            if (xHigher || compare(x, y, yn) >= 0) {
+                subtract(r, x, xn, y, yn);
+                return false;
+            }
+            subtract(r, y, yn, x, yn);
+            std::fill(r + yn, r + xn, 0);
+            return true;
+        }
+
+        void multiplySchoolbook(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            std::fill(r, r + an + bn, 0);
+            for (size_t i = 0; i < an; ++i) {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < bn; ++j) {
+                    uint128_t prod = static_cast<uint128_t>(a[i]) * b[j] + r[i + j] + carry;
+                    r[i + j] = static_cast<uint64_t>(prod);
+                    carry = static_cast<uint64_t>(prod >> 64);
+                }
+                r[i + bn] = carry;
+            }
+        }
+
+        // r[0..2n) = a^2. Each cross product a[i] * a[j] (i < j) is computed once,
+        // the sum is doubled with a shift, then the diagonal squares are added.
+        void squareSchoolbook(uint64_t *r, const uint64_t *a, size_t n) {
+            std::fill(r, r + 2 * n, 0);
+            for (size_t i = 0; i + 1 < n; ++i) {
+                uint64_t carry = 0;
+                for (size_t j = i + 1; j < n; ++j) {
+                    uint128_t prod = static_cast<uint128_t>(a[i]) * a[j] + r[i + j] + carry;
+                    r[i + j] = static_cast<uint64_t>(prod);
+                    carry = static_cast<uint64_t>(prod >> 64);
+                }
+                r[i + n] = carry;
+            }
+            shiftLeftOne(r, 2 * n);
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint128_t square = static_cast<uint128_t>(a[i]) * a[i];
+                uint128_t low = static_cast<uint128_t>(r[2 * i]) + static_cast<uint64_t>(square) + carry;
+                uint128_t high = static_cast<uint128_t>(r[2 * i + 1]) + static_cast<uint64_t>(square >> 64) +
+                                 static_cast<uint64_t>(low >> 64);
+                r[2 * i] = static_cast<uint64_t>(low);
+                r[2 * i + 1] = static_cast<uint64_t>(high);
+                carry = static_cast<uint64_t>(high >> 64);
+            }
+        }
+
+        // Dispatches to the squaring variants when a and b are the same array,
+        // so the recursive algorithms below square their sub-operands too.
+        void multiplyBalanced(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *scratch);
+
+        // Subtractive Karatsuba: a*b = z2*B^2h + (z0 + z2 - (a1-a0)(b1-b0))*B^h + z0.
+        void multiplyKaratsuba(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *scratch) {
+            size_t h = n / 2;
+            size_t k = n - h;
+
+            uint64_t *diffA = scratch;
+            uint64_t *diffB = diffA + k;
+            uint64_t *prod = diffB + k;
+            uint64_t *mid = prod + 2 * k;
+            uint64_t *next = mid + 2 * k + 1;
+
+            bool negA = absoluteDifference(diffA, a + h, k, a, h);
+            bool negB = negA;
+            if (a == b) { diffB = diffA; }
+            else { negB = absoluteDifference(diffB, b + h, k, b, h); }
+
+            multiplyBalanced(r, a, b, h, next);
+            multiplyBalanced(r + 2 * h, a + h, b + h, k, next);
+            multiplyBalanced(prod, diffA, diffB, k, next);
+
+            mid[2 * k] = add(mid, r + 2 * h, 2 * k, r, 2 * h);
+            if (negA == negB) { subtractFrom(mid, 2 * k + 1, prod, 2 * k); }
+            else { addInto(mid, 2 * k + 1, prod, 2 * k); }
+
+            addInto(r + h, 2 * n - h, mid, 2 * k + 1);
+        }
+
+        // Evaluates a0 + a1*x + a2*x^2 at 1, -1 and -2 as (k + 1)-limb two's complement values.
+        void evaluateToom3(const uint64_t *a, size_t n, size_t k, uint64_t *p1, uint64_t *pm1, uint64_t *pm2,
+                           uint64_t *temp) {
+            size_t e = k + 1;
+            uint64_t *a0 = temp;
+            uint64_t *a1 = a0 + e;
+            uint64_t *a2 = a1 + e;
+            copyPadded(a0, e, a, k);
+            copyPadded(a1, e, a + k, k);
+            copyPadded(a2, e, a + 2 * k, n - 2 * k);
+
+            add(pm1, a0, e, a2, e);
+            add(p1, pm1, e, a1, e);
+            subtract(pm1, pm1, e, a1, e);
+            add(pm2, pm1, e, a2, e);
+            shiftLeftOne(pm2, e);
+            subtract(pm2, pm2, e, a0, e);
+        }
+
+        // Toom-Cook-3 with evaluation points 0, 1, -1, -2 and infinity, using
+        // Bodrato's interpolation sequence.
+        void multiplyToom3(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *scratch) {
+            size_t k = (n + 2) / 3;
+            size_t top = n - 2 * k;
+            size_t e = k + 1;
+            size_t w = 2 * e;
+
+            uint64_t *p1 = scratch;
+            uint64_t *pm1 = p1 + e;
+            uint64_t *pm2 = pm1 + e;
+            uint64_t *q1 = pm2 + e;
+            uint64_t *qm1 = q1 + e;
+            uint64_t *qm2 = qm1 + e;
+            uint64_t *r1 = qm2 + e;
+            uint64_t *rm1 = r1 + w;
+            uint64_t *rm2 = rm1 + w;
+            uint64_t *r0 = rm2 + w;
+            uint64_t *rInf = r0 + w;
+            uint64_t *temp = rInf + w;
+            uint64_t *next = temp + std::max(w, 3 * e);
+
+            evaluateToom3(a, n, k, p1, pm1, pm2, temp);
+            if (a == b) {
+                // Squaring: the point values are shared and their squares are never negative.
+                q1 = p1;
+                qm1 = pm1;
+                qm2 = pm2;
+            } else { evaluateToom3(b, n, k, q1, qm1, qm2, temp); }
+
+            bool negM1 = isNegative(pm1, e) != isNegative(qm1, e);
+            bool negM2 = isNegative(pm2, e) != isNegative(qm2, e);
+            for (uint64_t *value: {pm1, pm2}) {
+                if (isNegative(value, e)) { negate(value, e); }
+            }
+            for (uint64_t *value: {qm1, qm2}) {
+                if (value != pm1 && value != pm2 && isNegative(value, e)) { negate(value, e); }
+            }
+
+            multiplyBalanced(r1, p1, q1, e, next);
+            multiplyBalanced(rm1, pm1, qm1, e, next);
+            multiplyBalanced(rm2, pm2, qm2, e, next);
+            if (negM1) { negate(rm1, w); }
+            if (negM2) { negate(rm2, w); }
+
+            std::fill(r + 2 * k, r + 4 * k, 0);
+            multiplyBalanced(r, a, b, k, next);
+            multiplyBalanced(r + 4 * k, a + 2 * k, b + 2 * k, top, next);
+            copyPadded(r0, w, r, 2 * k);
+            copyPadded(rInf, w, r + 4 * k, 2 * top);
+
+            // r3 lives in rm2, r2 in rm1.
+            subtract(rm2, rm2, w, r1, w);
+            divideExactByThree(rm2, w);
+            subtract(r1, r1, w, rm1, w);
+            shiftRightOneSigned(r1, w);
+            subtract(rm1, rm1, w, r0, w);
+            subtract(rm2, rm1, w, rm2, w);
+            shiftRightOneSigned(rm2, w);
+            copyPadded(temp, w, rInf, w);
+            shiftLeftOne(temp, w);
+            add(rm2, rm2, w, temp, w);
+            add(rm1, rm1, w, r1, w);
+            subtract(rm1, rm1, w, rInf, w);
+            subtract(r1, r1, w, rm2, w);
+
+            size_t total = 2 * n;
+            addInto(r + k, total - k, r1, std::min(w, total - k));
+            addInto(r + 2 * k, total - 2 * k, rm1, std::min(w, total - 2 * k));
+            addInto(r + 3 * k, total - 3 * k, rm2, std::min(w, total - 3 * k));
+        }
+
+        // Arithmetic modulo an NTT-friendly prime p = c * 2^40 + 1 < 2^62, with
+        // values kept in Montgomery form (x * 2^64 mod p).
+        class NttField {
+        public:
+            constexpr NttField(uint64_t Modulus, uint64_t Generator)
+                    : Modulus(Modulus), Generator(Generator), NegInverse(computeNegInverse(Modulus)),
+                      RSquared(static_cast<uint64_t>(computeRModulus(Modulus) * computeRModulus(Modulus) % Modulus)) {}
+
+            [[nodiscard]] constexpr uint64_t modulus() const { return Modulus; }
+
+            // t must be below p * 2^64; returns t / 2^64 mod p.
+            [[nodiscard]] uint64_t reduce(uint128_t t) const {
+                uint64_t m = static_cast<uint64_t>(t) * NegInverse;
+                uint64_t u = static_cast<uint64_t>((t + static_cast<uint128_t>(m) * Modulus) >> 64);
+                return u >= Modulus ? u - Modulus : u;
+            }
+
+            // One operand may be any 64-bit value; the other must be reduced.
+            [[nodiscard]] uint64_t mul(uint64_t a, uint64_t b) const { return reduce(static_cast<uint128_t>(a) * b); }
+
+            [[nodiscard]] uint64_t add(uint64_t a, uint64_t b) const {
+                uint64_t s = a + b;
+                return s >= Modulus ? s - Modulus : s;
+            }
+
+            [[nodiscard]] uint64_t sub(uint64_t a, uint64_t b) const { return a >= b ? a - b : a + Modulus - b; }
+
+            [[nodiscard]] uint64_t toMontgomery(uint64_t x) const { return mul(x, RSquared); }
+
+            [[nodiscard]] uint64_t pow(uint64_t base, uint64_t exponent) const {
+                uint64_t result = toMontgomery(1);
+                while (exponent) {
+                    if (exponent & 1) { result = mul(result, base); }
+                    base = mul(base, base);
+                    exponent >>= 1;
+                }
+                return result;
+            }
+
+            [[nodiscard]] uint64_t inverse(uint64_t x) const { return pow(x, Modulus - 2); }
+
+            // Gentleman-Sande forward transform: natural order in, bit-reversed order out.
+            void forward(uint64_t *a, size_t n) const {
+                std::vector<uint64_t> twiddles = buildTwiddles(n, false);
+                for (size_t len = n / 2; len >= 1; len >>= 1) {
+                    for (size_t start = 0; start < n; start += 2 * len) {
+                        for (size_t j = 0; j < len; ++j) {
+                            uint64_t u = a[start + j];
+                            uint64_t v = a[start + j + len];
+                            a[start + j] = add(u, v);
+                            a[start + j + len] = mul(sub(u, v), twiddles[len + j]);
+                        }
+                    }
+                }
+            }
+
+            // Cooley-Tukey inverse transform: bit-reversed order in, natural order out, unscaled.
+            void inverse(uint64_t *a, size_t n) const {
+                std::vector<uint64_t> twiddles = buildTwiddles(n, true);
+                for (size_t len = 1; len < n; len <<= 1) {
+                    for (size_t start = 0; start < n; start += 2 * len) {
+                        for (size_t j = 0; j < len; ++j) {
+                            uint64_t u = a[start + j];
+                            uint64_t v = mul(a[start + j + len], twiddles[len + j]);
+                            a[start + j] = add(u, v);
+                            a[start + j + len] = sub(u, v);
+                        }
+                    }
+                }
+            }
+
+        private:
+            uint64_t Modulus;
+            uint64_t Generator;
+            uint64_t NegInverse;
+            uint64_t RSquared;
+
+            static constexpr uint64_t computeNegInverse(uint64_t p) {
+                uint64_t inv = p;
+                for (int i = 0; i < 5; ++i) { inv *= 2 - p * inv; }
+                return ~inv + 1;
+            }
+
+            static constexpr uint128_t computeRModulus(uint64_t p) {
+                return (static_cast<uint128_t>(1) << 64) % p;
+            }
+
+            // twiddles[len + j] = w^j where w is a primitive (2 * len)-th root of unity.
+            [[nodiscard]] std::vector<uint64_t> buildTwiddles(size_t n, bool inverted) const {
+                std::vector<uint64_t> twiddles(std::max<size_t>(n, 2));
+                for (size_t len = 1; len < n; len <<= 1) {
+                    uint64_t root = pow(toMontgomery(Generator), (Modulus - 1) / (2 * len));
+                    if (inverted) { root = inverse(root); }
+                    uint64_t w = toMontgomery(1);
+                    for (size_t j = 0; j < len; ++j) {
+                        twiddles[len + j] = w;
+                        w = mul(w, root);
+                    }
+                }
+                return twiddles;
+            }
+        };
+
+        constexpr NttField NttFields[3] = {
+                NttField(4611615649683210241ULL, 11),
+                NttField(4611613450659954689ULL, 3),
+                NttField(4611549678985543681ULL, 19)};
+
+        // Cyclic convolution of a and b modulo one prime; writes plain residues to out[0..n).
+        void convolveModulo(const NttField &field, uint64_t *out, uint64_t *temp, size_t n,
+                            const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            for (size_t i = 0; i < n; ++i) { out[i] = i < an ? field.toMontgomery(a[i]) : 0; }
+            field.forward(out, n);
+            if (a == b && an == bn) {
+                // Squaring needs only one forward transform.
+                for (size_t i = 0; i < n; ++i) { out[i] = field.mul(out[i], out[i]); }
+            } else {
+                for (size_t i = 0; i < n; ++i) { temp[i] = i < bn ? field.toMontgomery(b[i]) : 0; }
+                field.forward(temp, n);
+                for (size_t i = 0; i < n; ++i) { out[i] = field.mul(out[i], temp[i]); }
+            }
+            field.inverse(out, n);
+            // Multiplying a Montgomery value by a plain one leaves a plain result.
+            uint64_t scale = field.mul(field.inverse(field.toMontgomery(n)), 1);
+            for (size_t i = 0; i < n; ++i) { out[i] = field.mul(out[i], scale); }
+        }
+
+        // Three-prime NTT product. Each 64-bit limb is one coefficient: a convolution
+        // term is below n * 2^128, well inside the ~2^186 product of the primes, and
+        // Garner's algorithm rebuilds it exactly before carries are propagated.
+        void multiplyNtt(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            size_t terms = an + bn - 1;
+            size_t n = 1;
+            while (n < terms) { n <<= 1; }
+
+            std::vector<uint64_t> residues(3 * n);
+            std::vector<uint64_t> temp(a == b && an == bn ? 0 : n);
+            for (size_t f = 0; f < 3; ++f) {
+                convolveModulo(NttFields[f], residues.data() + f * n, temp.data(), n, a, an, b, bn);
+            }
+
+            const NttField &f1 = NttFields[0];
+            const NttField &f2 = NttFields[1];
+            const NttField &f3 = NttFields[2];
+            uint64_t p1 = f1.modulus();
+            uint64_t p2 = f2.modulus();
+            uint128_t p1p2 = static_cast<uint128_t>(p1) * p2;
+            uint64_t inv12 = f2.inverse(f2.toMontgomery(p1));
+            uint64_t p1Mod3 = f3.toMontgomery(p1);
+            uint64_t inv123 = f3.inverse(f3.toMontgomery(f3.mul(p1, f3.toMontgomery(p2))));
+            uint64_t one2 = f2.toMontgomery(1);
+            uint64_t one3 = f3.toMontgomery(1);
+
+            uint64_t carry0 = 0, carry1 = 0, carry2 = 0;
+            for (size_t i = 0; i < an + bn; ++i) {
+                uint64_t x0 = 0, x1 = 0, x2 = 0;
+                if (i < terms) {
+                    uint64_t r1 = residues[i];
+                    uint64_t r2 = residues[n + i];
+                    uint64_t r3 = residues[2 * n + i];
+                    uint64_t v2 = f2.mul(f2.sub(r2, f2.mul(r1, one2)), inv12);
+                    uint64_t t = f3.add(f3.mul(r1, one3), f3.mul(v2, p1Mod3));
+                    uint64_t v3 = f3.mul(f3.sub(r3, t), inv123);
+
+                    uint128_t low = static_cast<uint128_t>(p1) * v2 + r1;
+                    uint128_t part0 = static_cast<uint128_t>(static_cast<uint64_t>(p1p2)) * v3;
+                    uint128_t part1 = static_cast<uint128_t>(static_cast<uint64_t>(p1p2 >> 64)) * v3;
+                    uint128_t sum0 = static_cast<uint128_t>(static_cast<uint64_t>(low)) + static_cast<uint64_t>(part0);
+                    uint128_t sum1 = static_cast<uint128_t>(static_cast<uint64_t>(low >> 64)) +
+                                     static_cast<uint64_t>(part0 >> 64) + static_cast<uint64_t>(part1) +
+                                     static_cast<uint64_t>(sum0 >> 64);
+                    x0 = static_cast<uint64_t>(sum0);
+                    x1 = static_cast<uint64_t>(sum1);
+                    x2 = static_cast<uint64_t>(part1 >> 64) + static_cast<uint64_t>(sum1 >> 64);
+                }
+                uint128_t acc0 = static_cast<uint128_t>(x0) + carry0;
+                uint128_t acc1 = static_cast<uint128_t>(x1) + carry1 + static_cast<uint64_t>(acc0 >> 64);
+                uint128_t acc2 = static_cast<uint128_t>(x2) + carry2 + static_cast<uint64_t>(acc1 >> 64);
+                r[i] = static_cast<uint64_t>(acc0);
+                carry0 = static_cast<uint64_t>(acc1);
+                carry1 = static_cast<uint64_t>(acc2);
+                carry2 = static_cast<uint64_t>(acc2 >> 64);
+            }
+        }
+
+        void multiplyBalanced(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *scratch) {
+            if (a == b && n < SquareKaratsubaThreshold) { squareSchoolbook(r, a, n); }
+            else if (n < KaratsubaThreshold) { multiplySchoolbook(r, a, n, b, n); }
+            else if (n < Toom3Threshold) { multiplyKaratsuba(r, a, b, n, scratch); }
+            else { multiplyToom3(r, a, b, n, scratch); }
+        }
+    }
+
+    namespace {
+        // Carry-chain kernel over n limbs of both operands; returns the carry
+        // (or borrow) out.
+        using CarryKernel = uint64_t (*)(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t carry);
+
+        uint64_t addScalar(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t carry) {
+            for (size_t i = 0; i < n; ++i) {
+                uint128_t sum = static_cast<uint128_t>(a[i]) + b[i] + carry;
+                r[i] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            return carry;
+        }
+
+        uint64_t subtractScalar(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t borrow) {
+            for (size_t i = 0; i < n; ++i) {
+                uint128_t diff = static_cast<uint128_t>(a[i]) - b[i] - borrow;
+                r[i] = static_cast<uint64_t>(diff);
+                borrow = static_cast<uint64_t>(diff >> 64) & 1;
+            }
+            return borrow;
+        }
+
+#if defined(__x86_64__)
+        // Four limbs per step. Lane-wise sums give a generate mask (the lane
+        // overflowed) and a propagate mask (the lane is all ones, so an incoming
+        // carry passes through); adding the two 4-bit masks as integers ripples
+        // the carries across lanes in one instruction, the parallel-prefix trick.
+        __attribute__((target("avx2")))
+        uint64_t addAvx2(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t carry) {
+            const __m256i signBit = _mm256_set1_epi64x(INT64_MIN);
+            const __m256i allOnes = _mm256_set1_epi64x(-1);
+            const __m256i laneBits = _mm256_setr_epi64x(1, 2, 4, 8);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                __m256i sum = _mm256_add_epi64(left, right);
+                __m256i overflow = _mm256_cmpgt_epi64(_mm256_xor_si256(left, signBit), _mm256_xor_si256(sum, signBit));
+                auto generate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(overflow)));
+                auto propagate = static_cast<unsigned>(
+                        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, allOnes))));
+                unsigned chain = ((generate << 1) | static_cast<unsigned>(carry)) + propagate;
+                unsigned incoming = (chain ^ propagate) & 0xF;
+                carry = chain >> 4;
+                __m256i increment = _mm256_cmpeq_epi64(
+                        _mm256_and_si256(_mm256_set1_epi64x(incoming), laneBits), laneBits);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_sub_epi64(sum, increment));
+            }
+            return addScalar(r + i, a + i, b + i, n - i, carry);
+        }
+
+        // Same scheme for borrows: a lane generates when b > a and propagates
+        // when its difference is zero.
+        __attribute__((target("avx2")))
+        uint64_t subtractAvx2(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t borrow) {
+            const __m256i signBit = _mm256_set1_epi64x(INT64_MIN);
+            const __m256i laneBits = _mm256_setr_epi64x(1, 2, 4, 8);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                __m256i diff = _mm256_sub_epi64(left, right);
+                __m256i underflow = _mm256_cmpgt_epi64(_mm256_xor_si256(right, signBit),
+                                                       _mm256_xor_si256(left, signBit));
+                auto generate = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(underflow)));
+                auto propagate = static_cast<unsigned>(_mm256_movemask_pd(
+                        _mm256_castsi256_pd(_mm256_cmpeq_epi64(diff, _mm256_setzero_si256()))));
+                unsigned chain = ((generate << 1) | static_cast<unsigned>(borrow)) + propagate;
+                unsigned incoming = (chain ^ propagate) & 0xF;
+                borrow = chain >> 4;
+                __m256i decrement = _mm256_cmpeq_epi64(
+                        _mm256_and_si256(_mm256_set1_epi64x(incoming), laneBits), laneBits);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_add_epi64(diff, decrement));
+            }
+            return subtractScalar(r + i, a + i, b + i, n - i, borrow);
+        }
+#endif
+
+        struct CarryKernels {
+            CarryKernel Add;
+            CarryKernel Subtract;
+        };
+
+        // Chosen once from the running CPU, so one binary serves machines
+        // with and without AVX2.
+        const CarryKernels &carryKernels() {
+            static const CarryKernels kernels = [] {
+#if defined(__x86_64__)
+                if (__builtin_cpu_supports("avx2")) { return CarryKernels{addAvx2, subtractAvx2}; }
+#endif
+                return CarryKernels{addScalar, subtractScalar};
+            }();
+            return kernels;
+        }
+    }
+
+    uint64_t add(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+        uint64_t carry = bn >= VectorCarryThreshold ? carryKernels().Add(r, a, b, bn, 0) : addScalar(r, a, b, bn, 0);
+        for (size_t i = bn; i < an; ++i) {
+            uint128_t sum = static_cast<uint128_t>(a[i]) + carry;
+            r[i] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        return carry;
+    }
+
+    uint64_t subtract(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+        uint64_t borrow = bn >= VectorCarryThreshold ? carryKernels().Subtract(r, a, b, bn, 0)
+                                                     : subtractScalar(r, a, b, bn, 0);
+        for (size_t i = bn; i < an; ++i) {
+            uint128_t diff = static_cast<uint128_t>(a[i]) - borrow;
+            r[i] = static_cast<uint64_t>(diff);
+            borrow = static_cast<uint64_t>(diff >> 64) & 1;
+        }
+        return borrow;
+    }
+
+    int compare(const uint64_t *a, const uint64_t *b, size_t n) {
+        for (size_t i = n; i-- > 0;) {
+            if (a[i] > b[i]) return 1;
+            if (a[i] < b[i]) return -1;
+        }
+        return 0;
+    }
+
+    uint64_t divideSingle(uint64_t *q, const uint64_t *a, size_t an, uint64_t d) {
+        if (an == 0) { return 0; }
+        // Moller-Granlund: with d normalized and v = floor((B^2 - 1) / d) - B,
+        // each 2-by-1 step costs two multiplications instead of a hardware divide.
+        int shift = std::countl_zero(d);
+        uint64_t dn = d << shift;
+        uint64_t v = static_cast<uint64_t>(((static_cast<uint128_t>(~dn) << 64) | ~uint64_t{0}) / dn);
+        uint64_t remainder = shift ? a[an - 1] >> (64 - shift) : 0;
+        for (size_t i = an; i-- > 0;) {
+            uint64_t limb = (a[i] << shift) | (shift && i ? a[i - 1] >> (64 - shift) : 0);
+            uint128_t estimate = static_cast<uint128_t>(v) * remainder +
+                                 ((static_cast<uint128_t>(remainder + 1) << 64) | limb);
+            uint64_t quotient = static_cast<uint64_t>(estimate >> 64);
+            uint64_t rest = limb - quotient * dn;
+            if (rest > static_cast<uint64_t>(estimate)) {
+                --quotient;
+                rest += dn;
+            }
+            if (rest >= dn) {
+                ++quotient;
+                rest -= dn;
+            }
+            if (q) { q[i] = quotient; }
+            remainder = rest;
+        }
+        return remainder >> shift;
+    }
+
+    namespace {
+        using LimbVector = std::vector<uint64_t>;
+
+        void trim(LimbVector &num) {
+            while (!num.empty() && num.back() == 0) { num.pop_back(); }
+        }
+
+        int compareTrimmed(const LimbVector &a, const uint64_t *b, size_t bn) {
+            if (a.size() != bn) { return a.size() < bn ? -1 : 1; }
+            return compare(a.data(), b, bn);
+        }
+
+        LimbVector multiplyTrimmed(const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            if (an == 0 || bn == 0) { return {}; }
+            LimbVector result(an + bn);
+            multiply(result.data(), a, an, b, bn);
+            trim(result);
+            return result;
+        }
+
+        // a -= b for trimmed a >= b.
+        void subtractTrimmed(LimbVector &a, const uint64_t *b, size_t bn) {
+            subtract(a.data(), a.data(), a.size(), b, bn);
+            trim(a);
+        }
+
+        void addOne(LimbVector &a) {
+            for (uint64_t &limb: a) {
+                if (++limb != 0) { return; }
+            }
+            a.push_back(1);
+        }
+
+        void subtractOne(LimbVector &a) {
+            for (uint64_t &limb: a) {
+                if (limb-- != 0) { break; }
+            }
+            trim(a);
+        }
+
+        // Algorithm D with caller-provided work space of an + 1 + bn limbs.
+        void divideKnuth(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn,
+                         uint64_t *work) {
+            // Normalize so the divisor's top bit is set; the quotient estimate
+            // from the top two limbs is then at most two too large.
+            int shift = std::countl_zero(b[bn - 1]);
+            uint64_t *u = work;
+            uint64_t *v = u + an + 1;
+            for (size_t i = bn; i-- > 0;) {
+                v[i] = (b[i] << shift) | (shift && i ? b[i - 1] >> (64 - shift) : 0);
+            }
+            u[an] = shift ? a[an - 1] >> (64 - shift) : 0;
+            for (size_t i = an; i-- > 0;) {
+                u[i] = (a[i] << shift) | (shift && i ? a[i - 1] >> (64 - shift) : 0);
+            }
+
+            uint64_t vTop = v[bn - 1];
+            uint64_t vNext = v[bn - 2];
+            for (size_t j = an - bn + 1; j-- > 0;) {
+                uint128_t numerator = (static_cast<uint128_t>(u[j + bn]) << 64) | u[j + bn - 1];
+                uint128_t qHat = u[j + bn] >= vTop ? ~uint64_t{0} : numerator / vTop;
+                uint128_t rHat = numerator - qHat * vTop;
+                while (rHat >> 64 == 0 && qHat * vNext > ((rHat << 64) | u[j + bn - 2])) {
+                    --qHat;
+                    rHat += vTop;
+                }
+
+                // u[j..j+bn] -= qHat * v
+                uint64_t mulCarry = 0;
+                uint64_t borrow = 0;
+                for (size_t i = 0; i < bn; ++i) {
+                    uint128_t prod = qHat * v[i] + mulCarry;
+                    mulCarry = static_cast<uint64_t>(prod >> 64);
+                    uint64_t low = static_cast<uint64_t>(prod);
+                    uint128_t diff = static_cast<uint128_t>(u[j + i]) - low - borrow;
+                    u[j + i] = static_cast<uint64_t>(diff);
+                    borrow = static_cast<uint64_t>(diff >> 64) & 1;
+                }
+                uint128_t diff = static_cast<uint128_t>(u[j + bn]) - mulCarry - borrow;
+                u[j + bn] = static_cast<uint64_t>(diff);
+
+                if (static_cast<uint64_t>(diff >> 64) & 1) {
+                    --qHat;
+                    u[j + bn] += add(u + j, u + j, bn, v, bn);
+                }
+                if (q) { q[j] = static_cast<uint64_t>(qHat); }
+            }
+
+            if (r) {
+                for (size_t i = 0; i < bn; ++i) {
+                    r[i] = (u[i] >> shift) | (shift ? u[i + 1] << (64 - shift) : 0);
+                }
+            }
+        }
+
+        void divideKnuth(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            std::vector<uint64_t> work(an + 1 + bn);
+            divideKnuth(q, r, a, an, b, bn, work.data());
+        }
+    }
+
+    void divide(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+        if (bn == 1) {
+            uint64_t remainder = divideSingle(q, a, an, b[0]);
+            if (r) { r[0] = remainder; }
+            return;
+        }
+        if (bn >= NewtonDivisionThreshold && an - bn >= NewtonDivisionThreshold) {
+            divideWithReciprocal(q, r, a, an, b, bn, reciprocal(b, bn));
+            return;
+        }
+        divideKnuth(q, r, a, an, b, bn);
+    }
+
+    std::vector<uint64_t> reciprocal(const uint64_t *b, size_t bn) {
+        LimbVector power(2 * bn + 1, 0);
+        power[2 * bn] = 1;
+        if (bn < 2 * KaratsubaThreshold) {
+            LimbVector inverse(bn + 2);
+            divideKnuth(inverse.data(), nullptr, power.data(), power.size(), b, bn);
+            trim(inverse);
+            return inverse;
+        }
+
+        // Start from the reciprocal of the top h limbs, which carries about
+        // h limbs of precision; one Newton step x += x * (B^2n - b * x) / B^2n
+        // doubles that past n limbs, leaving only a few units to correct.
+        size_t h = bn / 2 + 2;
+        size_t shift = bn - h;
+        LimbVector top = reciprocal(b + shift, h);
+        LimbVector x(shift, 0);
+        x.insert(x.end(), top.begin(), top.end());
+
+        LimbVector product = multiplyTrimmed(b, bn, x.data(), x.size());
+        bool under = compareTrimmed(product, power.data(), power.size()) <= 0;
+        LimbVector error = under ? power : product;
+        subtractTrimmed(error, under ? product.data() : power.data(), under ? product.size() : power.size());
+        LimbVector correction = multiplyTrimmed(top.data(), top.size(), error.data(), error.size());
+        size_t dropped = 2 * bn - shift;
+        correction.erase(correction.begin(), correction.begin() + static_cast<std::ptrdiff_t>(
+                std::min(dropped, correction.size())));
+        if (under) {
+            x.resize(std::max(x.size(), correction.size()) + 1, 0);
+            add(x.data(), x.data(), x.size(), correction.data(), correction.size());
+            trim(x);
+        } else {
+            addOne(correction);
+            subtractTrimmed(x, correction.data(), correction.size());
+        }
+
+        product = multiplyTrimmed(b, bn, x.data(), x.size());
+        while (compareTrimmed(product, power.data(), power.size()) > 0) {
+            subtractOne(x);
+            subtractTrimmed(product, b, bn);
+        }
+        LimbVector remainder = power;
+        subtractTrimmed(remainder, product.data(), product.size());
+        while (compareTrimmed(remainder, b, bn) >= 0) {
+            addOne(x);
+            subtractTrimmed(remainder, b, bn);
+        }
+        return x;
+    }
+
+    void divideWithReciprocal(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn,
+                              const std::vector<uint64_t> &inverse) {
+        // Long division in base B^bn: every step divides a value below b * B^bn
+        // by b with one Barrett estimate and at most two corrections.
+        LimbVector quotient(an, 0);
+        LimbVector remainder;
+        size_t position = an;
+        size_t step = an % bn == 0 ? bn : an % bn;
+        while (position > 0) {
+            position -= step;
+            LimbVector current(a + position, a + position + step);
+            current.insert(current.end(), remainder.begin(), remainder.end());
+            trim(current);
+            step = bn;
+
+            if (current.size() < bn) {
+                remainder = std::move(current);
+                continue;
+            }
+            LimbVector estimate = multiplyTrimmed(current.data() + bn - 1, current.size() - (bn - 1),
+                                                  inverse.data(), inverse.size());
+            LimbVector digit(estimate.begin() + static_cast<std::ptrdiff_t>(std::min(bn + 1, estimate.size())),
+                             estimate.end());
+            LimbVector product = multiplyTrimmed(digit.data(), digit.size(), b, bn);
+            subtractTrimmed(current, product.data(), product.size());
+            while (compareTrimmed(current, b, bn) >= 0) {
+                subtractTrimmed(current, b, bn);
+                addOne(digit);
+            }
+            std::copy(digit.begin(), digit.end(), quotient.begin() + static_cast<std::ptrdiff_t>(position));
+            remainder = std::move(current);
+        }
+
+        if (q) { std::copy(quotient.begin(), quotient.begin() + static_cast<std::ptrdiff_t>(an - bn + 1), q); }
+        if (r) {
+            std::copy(remainder.begin(), remainder.end(), r);
+            std::fill(r + remainder.size(), r + bn, 0);
+        }
+    }
+
+    namespace {
+        __extension__ typedef __int128 int128_t;
+
+        // Lehmer works on the leading 62 bits so that single-word cofactors and
+        // their sums stay clear of int64_t overflow.
+        constexpr size_t LehmerBits = 62;
+
+        int countTrailingZeros(uint128_t x) {
+            auto low = static_cast<uint64_t>(x);
+            return low ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<uint64_t>(x >> 64));
+        }
+
+        uint128_t binaryGcd(uint128_t x, uint128_t y) {
+            if (x == 0) { return y; }
+            if (y == 0) { return x; }
+            int shift = countTrailingZeros(x | y);
+            x >>= countTrailingZeros(x);
+            do {
+                y >>= countTrailingZeros(y);
+                if (x > y) { std::swap(x, y); }
+                y -= x;
+            } while (y != 0);
+            return x << shift;
+        }
+
+        // Bits [shift, shift + LehmerBits) of x, reading limbs past n as zero.
+        int64_t leadingBits(const LimbVector &x, size_t shift) {
+            size_t limb = shift / 64;
+            uint128_t window = 0;
+            if (limb < x.size()) { window = x[limb]; }
+            if (limb + 1 < x.size()) { window |= static_cast<uint128_t>(x[limb + 1]) << 64; }
+            return static_cast<int64_t>(static_cast<uint64_t>(window >> (shift % 64)) &
+                                        ((uint64_t{1} << LehmerBits) - 1));
+        }
+
+        // r[0..n) = x * a + y * b for single-word x, y of opposite signs whose
+        // result is known to be a nonnegative n-limb value.
+        void combineSigned(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, int64_t x, int64_t y) {
+            int128_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                int128_t acc = static_cast<int128_t>(x) * a[i] + static_cast<int128_t>(y) * b[i] + carry;
+                r[i] = static_cast<uint64_t>(acc);
+                carry = acc >> 64;
+            }
+        }
+
+        // r[0..rn) += a * b one row of a at a time; r must be long enough for
+        // the sum. Unlike multiply() it never allocates.
+        void multiplyAddRows(uint64_t *r, size_t rn, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+            for (size_t i = 0; i < an; ++i) {
+                uint64_t carry = 0;
+                for (size_t j = 0; j < bn; ++j) {
+                    uint128_t prod = static_cast<uint128_t>(a[i]) * b[j] + r[i + j] + carry;
+                    r[i + j] = static_cast<uint64_t>(prod);
+                    carry = static_cast<uint64_t>(prod >> 64);
+                }
+                for (size_t k = i + bn; carry && k < rn; ++k) { carry = (r[k] += carry) < carry; }
+            }
+        }
+
+        // r[0..n] = x * u + y * v for x, y < 2^62.
+        void combineMagnitudes(uint64_t *r, const uint64_t *u, const uint64_t *v, size_t n, uint64_t x, uint64_t y) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint128_t first = static_cast<uint128_t>(x) * u[i] + carry;
+                uint128_t second = static_cast<uint128_t>(y) * v[i] + static_cast<uint64_t>(first);
+                r[i] = static_cast<uint64_t>(second);
+                carry = static_cast<uint64_t>(first >> 64) + static_cast<uint64_t>(second >> 64);
+            }
+            r[n] = carry;
+        }
+    }
+
+    std::vector<uint64_t> gcd(const uint64_t *a, size_t an, const uint64_t *b, size_t bn,
+                              std::vector<uint64_t> *cofactor, bool *cofactorNegative, bool cofactorOfB) {
+        // Every buffer is sized for the inputs up front and only resized within
+        // its capacity afterwards, so neither the Lehmer steps nor the full
+        // division steps allocate inside the loop.
+        size_t capacity = an + 3;
+        LimbVector x;
+        LimbVector y;
+        LimbVector nextX;
+        LimbVector nextY;
+        LimbVector quotient;
+        LimbVector remainder;
+        LimbVector divideWork;
+        for (LimbVector *buffer: {&x, &y, &nextX, &nextY, &quotient, &remainder}) { buffer->reserve(capacity); }
+        divideWork.reserve(2 * capacity);
+        x.assign(a, a + an);
+        y.assign(b, b + bn);
+        trim(x);
+        trim(y);
+
+        // Remainder i of the Euclidean sequence is s_i * a + t_i * b, where s_i
+        // and t_i alternate in sign; only the tracked magnitude and the step
+        // parity are stored.
+        bool track = cofactor != nullptr;
+        LimbVector u;
+        LimbVector v;
+        LimbVector nextU;
+        LimbVector nextV;
+        LimbVector product;
+        size_t steps = 0;
+        if (track) {
+            for (LimbVector *buffer: {&u, &v, &nextU, &nextV, &product}) { buffer->reserve(capacity); }
+            (cofactorOfB ? v : u).push_back(1);
+        }
+
+        while (!y.empty()) {
+            if (!track && x.size() <= 2) {
+                uint128_t g = binaryGcd(static_cast<uint128_t>(x.size() > 1 ? x[1] : 0) << 64 | x[0],
+                                        static_cast<uint128_t>(y.size() > 1 ? y[1] : 0) << 64 | y[0]);
+                x.assign({static_cast<uint64_t>(g), static_cast<uint64_t>(g >> 64)});
+                trim(x);
+                return x;
+            }
+
+            // Knuth's Algorithm L: run Euclid on the leading bits while both
+            // bracketing quotients agree, accumulating the steps in a 2x2 matrix.
+            size_t n = x.size();
+            size_t bits = 64 * n - static_cast<size_t>(std::countl_zero(x.back()));
+            size_t shift = bits > LehmerBits ? bits - LehmerBits : 0;
+            int64_t xHat = leadingBits(x, shift);
+            int64_t yHat = leadingBits(y, shift);
+            int64_t A = 1, B = 0, C = 0, D = 1;
+            size_t inner = 0;
+            while (yHat + C > 0 && yHat + D > 0) {
+                int64_t q = (xHat + A) / (yHat + C);
+                if (q != (xHat + B) / (yHat + D)) { break; }
+                int64_t t = A - q * C;
+                A = C;
+                C = t;
+                t = B - q * D;
+                B = D;
+                D = t;
+                t = xHat - q * yHat;
+                xHat = yHat;
+                yHat = t;
+                ++inner;
+            }
+
+            if (B == 0) {
+                // The leading bits could not predict a quotient: take one full
+                // division step. Algorithm D runs in divideWork rather than
+                // through divide(), and the cofactor update multiplies by rows,
+                // since the quotient here is usually a limb or two.
+                quotient.resize(n - y.size() + 1);
+                remainder.resize(y.size());
+                if (y.size() == 1) { remainder[0] = divideSingle(quotient.data(), x.data(), n, y[0]); }
+                else {
+                    divideWork.resize(n + 1 + y.size());
+                    divideKnuth(quotient.data(), remainder.data(), x.data(), n, y.data(), y.size(), divideWork.data());
+                }
+                trim(quotient);
+                trim(remainder);
+                if (track && !v.empty()) {
+                    // u + q * v; the cofactor bounds keep it within an + 2 limbs.
+                    product.assign(u.begin(), u.end());
+                    product.resize(std::max(quotient.size() + v.size(), u.size()) + 1, 0);
+                    multiplyAddRows(product.data(), product.size(), quotient.data(), quotient.size(), v.data(),
+                                    v.size());
+                    trim(product);
+                    std::swap(u, product);
+                }
+                if (track) { std::swap(u, v); }
+                std::swap(x, y);
+                std::swap(y, remainder);
+                ++steps;
+                continue;
+            }
+
+            y.resize(n, 0);
+            nextX.resize(n);
+            nextY.resize(n);
+            combineSigned(nextX.data(), x.data(), y.data(), n, A, B);
+            combineSigned(nextY.data(), x.data(), y.data(), n, C, D);
+            std::swap(x, nextX);
+            std::swap(y, nextY);
+            trim(x);
+            trim(y);
+
+            if (track) {
+                // Cofactors alternate in sign, so each new one adds magnitudes.
+                size_t m = std::max(u.size(), v.size());
+                u.resize(m, 0);
+                v.resize(m, 0);
+                nextU.resize(m + 1);
+                nextV.resize(m + 1);
+                auto magnitude = [](int64_t value) { return static_cast<uint64_t>(value < 0 ? -value : value); };
+                combineMagnitudes(nextU.data(), u.data(), v.data(), m, magnitude(A), magnitude(B));
+                combineMagnitudes(nextV.data(), u.data(), v.data(), m, magnitude(C), magnitude(D));
+                std::swap(u, nextU);
+                std::swap(v, nextV);
+                trim(u);
+                trim(v);
+            }
+            steps += inner;
+        }
+
+        if (track) {
+            *cofactorNegative = (steps + cofactorOfB) % 2 == 1 && !u.empty();
+            *cofactor = std::move(u);
+        }
+        return x;
+    }
+
+    void inverseModPowerOfTwo(uint64_t *r, const uint64_t *a, size_t n) {
+        std::fill(r, r + n, 0);
+        r[0] = 0 - negativeInverse(a[0]);
+        LimbVector product(2 * n);
+        LimbVector correction(2 * n);
+        for (size_t w = 1; w < n;) {
+            // With a * x = 1 + 2^(64w) * h, the next x is x - 2^(64w) * (x * h),
+            // so only the limbs [w, next) change.
+            size_t next = std::min(2 * w, n);
+            multiply(product.data(), a, next, r, w);
+            multiply(correction.data(), r, next - w, product.data() + w, next - w);
+            std::copy(correction.begin(), correction.begin() + static_cast<std::ptrdiff_t>(next - w), r + w);
+            negate(r + w, next - w);
+            w = next;
+        }
+    }
+
+    size_t multiplyScratchSize(size_t n) {
+        if (n < KaratsubaThreshold) { return 0; }
+        if (n < Toom3Threshold) {
+            size_t k = n - n / 2;
+            return 6 * k + 1 + std::max(multiplyScratchSize(n / 2), multiplyScratchSize(k));
+        }
+        size_t k = (n + 2) / 3;
+        size_t e = k + 1;
+        size_t recursion = std::max({multiplyScratchSize(k), multiplyScratchSize(e), multiplyScratchSize(n - 2 * k)});
+        return 6 * e + 5 * 2 * e + std::max(2 * e, 3 * e) + recursion;
+    }
+
+    uint64_t negativeInverse(uint64_t m) {
+        uint64_t inverse = m;
+        for (int i = 0; i < 5; ++i) { inverse *= 2 - m * inverse; }
+        return ~inverse + 1;
+    }
+
+    void montgomeryMultiply(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, size_t n,
+                            uint64_t negInverse, uint64_t *scratch) {
+        uint64_t *t = scratch;
+        std::fill(t, t + n + 2, 0);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < n; ++j) {
+                uint128_t sum = static_cast<uint128_t>(a[j]) * b[i] + t[j] + carry;
+                t[j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            uint128_t top = static_cast<uint128_t>(t[n]) + carry;
+            t[n] = static_cast<uint64_t>(top);
+            t[n + 1] = static_cast<uint64_t>(top >> 64);
+
+            uint64_t factor = t[0] * negInverse;
+            uint128_t sum = static_cast<uint128_t>(factor) * m[0] + t[0];
+            carry = static_cast<uint64_t>(sum >> 64);
+            for (size_t j = 1; j < n; ++j) {
+                sum = static_cast<uint128_t>(factor) * m[j] + t[j] + carry;
+                t[j - 1] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            sum = static_cast<uint128_t>(t[n]) + carry;
+            t[n - 1] = static_cast<uint64_t>(sum);
+            t[n] = t[n + 1] + static_cast<uint64_t>(sum >> 64);
+        }
+        if (t[n] != 0 || compare(t, m, n) >= 0) { subtract(t, t, n, m, n); }
+        std::copy(t, t + n, r);
+    }
+
+    size_t windowBits(size_t exponentBits) {
+        if (exponentBits > 671) { return 6; }
+        if (exponentBits > 239) { return 5; }
+        if (exponentBits > 79) { return 4; }
+        if (exponentBits > 23) { return 3; }
+        return 1;
+    }
+
+    void square(uint64_t *r, const uint64_t *a, size_t n) {
+        if (n == 0) { return; }
+        if (n < SquareKaratsubaThreshold) {
+            squareSchoolbook(r, a, n);
+            return;
+        }
+        if (n >= NttThreshold) {
+            multiplyNtt(r, a, n, a, n);
+            return;
+        }
+        std::vector<uint64_t> scratch(multiplyScratchSize(n));
+        multiplyBalanced(r, a, a, n, scratch.data());
+    }
+
+    void multiply(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+        if (a == b && an == bn) {
+            square(r, a, an);
+            return;
+        }
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn == 0) {
+            std::fill(r, r + an, 0);
+            return;
+        }
+        if (bn < KaratsubaThreshold) {
+            multiplySchoolbook(r, a, an, b, bn);
+            return;
+        }
+        if (bn >= NttThreshold) {
+            multiplyNtt(r, a, an, b, bn);
+            return;
+        }
+
+        std::vector<uint64_t> scratch(multiplyScratchSize(bn));
+        if (an == bn) {
+            multiplyBalanced(r, a, b, bn, scratch.data());
+            return;
+        }
+
+        // Unbalanced operands: slice the longer one into bn-limb blocks.
+        std::fill(r, r + an + bn, 0);
+        std::vector<uint64_t> block(2 * bn);
+        for (size_t offset = 0; offset < an; offset += bn) {
+            size_t length = std::min(bn, an - offset);
+            if (length == bn) { multiplyBalanced(block.data(), a + offset, b, bn, scratch.data()); }
+            else { multiply(block.data(), b, bn, a + offset, length); }
+            addInto(r + offset, an + bn - offset, block.data(), length + bn);
+        }
+    }
+
+} // namespace BigNumberNamespace::LimbArithmetic
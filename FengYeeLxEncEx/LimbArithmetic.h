@@ -0,0 +1,152 @@
+// LimbArithmetic.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef LIMBARITHMETIC_HPP
+#define LIMBARITHMETIC_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Low-level kernels over little-endian arrays of 64-bit limbs. They do not
+// allocate unless stated otherwise and do not track signs; BigNumber owns
+// normalization and sign handling.
+namespace BigNumberNamespace::LimbArithmetic {
+
+    // Operand sizes (in limbs) at which multiplication switches from
+    // schoolbook to Karatsuba, from Karatsuba to Toom-Cook-3, and from
+    // Toom-Cook-3 to the three-prime number-theoretic transform.
+    constexpr size_t KaratsubaThreshold = 32;
+    constexpr size_t Toom3Threshold = 160;
+    constexpr size_t NttThreshold = 4096;
+
+    // Squaring halves the schoolbook work, so it stays quadratic longer. Tuned
+    // with bignumber_bench --square-limbs in a -O2 build: one level of
+    // Karatsuba over schoolbook halves breaks even between 40 and 64 limbs and
+    // is 9-30% faster from 66 to 100 limbs.
+    constexpr size_t SquareKaratsubaThreshold = 64;
+
+    // Divisor and quotient sizes (in limbs) from which division switches from
+    // Algorithm D to a Newton reciprocal followed by Barrett steps.
+    constexpr size_t NewtonDivisionThreshold = 768;
+
+    // Shortest operand (in limbs) handed to the runtime-selected vector carry
+    // kernels; below it the scalar loop wins on setup cost.
+    constexpr size_t VectorCarryThreshold = 16;
+
+    // r[0..an) = a + b with an >= bn; returns the carry out. r may alias a or b.
+    uint64_t add(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn);
+
+    // r[0..an) = a - b with an >= bn; returns the borrow out. r may alias a or b.
+    uint64_t subtract(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn);
+
+    // Three-way comparison of two equally sized arrays.
+    int compare(const uint64_t *a, const uint64_t *b, size_t n);
+
+    // r[0..an+bn) = a * b. r must not overlap a or b. Allocates one scratch
+    // block up front when a recursive algorithm is selected, or the transform
+    // buffers once the shorter operand reaches NttThreshold. Passing the same
+    // array twice dispatches to square().
+    void multiply(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn);
+
+    // r[0..2n) = a^2 with the same algorithm ladder as multiply(), computing
+    // each symmetric partial product once. r must not overlap a.
+    void square(uint64_t *r, const uint64_t *a, size_t n);
+
+    // q[0..an) = a / d; returns a % d. q may alias a, or be null when only the
+    // remainder is wanted. Uses a precomputed reciprocal of d, not hardware division.
+    uint64_t divideSingle(uint64_t *q, const uint64_t *a, size_t an, uint64_t d);
+
+    // q[0..an-bn+1) = a / b and r[0..bn) = a % b, for an >= bn and a nonzero
+    // top limb in b. Either output may be null. Uses Knuth Algorithm D, or a
+    // Newton reciprocal once both b and the quotient reach NewtonDivisionThreshold.
+    void divide(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn);
+
+    // floor(2^(128bn) / b) for b with a nonzero top limb, by Newton iteration
+    // with doubling precision; costs a small multiple of one bn x bn product.
+    std::vector<uint64_t> reciprocal(const uint64_t *b, size_t bn);
+
+    // divide() with a precomputed inverse = reciprocal(b, bn), for callers that
+    // divide many values by the same b.
+    void divideWithReciprocal(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn,
+                              const std::vector<uint64_t> &inverse);
+
+    // gcd(a, b) for a >= b >= 0, trimmed. Binary GCD finishes once both fit in
+    // two limbs; larger inputs run Lehmer's algorithm, applying single-word
+    // quotient sequences to the full operands in one linear pass per batch.
+    // With a cofactor output it also returns |x| and the sign of x such that
+    // a * x = gcd (mod b), or b * x = gcd (mod a) when cofactorOfB is set.
+    // The working buffers, including those of the rare full division step,
+    // are allocated once before the main loop.
+    std::vector<uint64_t> gcd(const uint64_t *a, size_t an, const uint64_t *b, size_t bn,
+                              std::vector<uint64_t> *cofactor = nullptr, bool *cofactorNegative = nullptr,
+                              bool cofactorOfB = false);
+
+    // r[0..n) = a^-1 mod 2^(64n) for odd a[0..n). Newton/Hensel lifting
+    // x <- x * (2 - a * x) doubles the number of correct limbs per step.
+    void inverseModPowerOfTwo(uint64_t *r, const uint64_t *a, size_t n);
+
+    // Scratch limbs needed by a balanced n x n multiplication.
+    size_t multiplyScratchSize(size_t n);
+
+    // -m^-1 mod 2^64 for an odd limb m.
+    uint64_t negativeInverse(uint64_t m);
+
+    // CIOS Montgomery product r = a * b / 2^(64n) mod m for a, b < m. The
+    // scratch needs n + 2 limbs; r may alias a or b.
+    void montgomeryMultiply(uint64_t *r, const uint64_t *a, const uint64_t *b, const uint64_t *m, size_t n,
+                            uint64_t negInverse, uint64_t *scratch);
+
+    // Window width used by sliding-window exponentiation for an exponent of
+    // the given bit length.
+    size_t windowBits(size_t exponentBits);
+
+    // Left-to-right sliding-window exponentiation over fixed-width residues.
+    // multiply(r, a, b) must accept r aliasing a or b; one is the identity in
+    // the residue representation and exponent holds en limbs.
+    template<typename Residue, typename Multiply>
+    Residue slidingWindowPow(const Residue &base, const uint64_t *exponent, size_t en, Residue one,
+                             Multiply &&multiply) {
+        while (en > 0 && exponent[en - 1] == 0) { --en; }
+        if (en == 0) { return one; }
+        size_t bits = 64 * en - static_cast<size_t>(std::countl_zero(exponent[en - 1]));
+        auto bitAt = [exponent](size_t i) { return (exponent[i / 64] >> (i % 64)) & 1; };
+
+        // table[i] = base^(2i + 1)
+        size_t window = windowBits(bits);
+        std::vector<Residue> table(size_t{1} << (window - 1), base);
+        if (table.size() > 1) {
+            Residue baseSquared = base;
+            multiply(baseSquared.data(), base.data(), base.data());
+            for (size_t i = 1; i < table.size(); ++i) {
+                multiply(table[i].data(), table[i - 1].data(), baseSquared.data());
+            }
+        }
+
+        Residue result = std::move(one);
+        size_t i = bits;
+        while (i > 0) {
+            if (!bitAt(i - 1)) {
+                multiply(result.data(), result.data(), result.data());
+                --i;
+                continue;
+            }
+            // Longest window [low, i) of at most `window` bits that ends in a set bit.
+            size_t low = i > window ? i - window : 0;
+            while (!bitAt(low)) { ++low; }
+            size_t value = 0;
+            for (size_t j = i; j-- > low;) {
+                value = (value << 1) | bitAt(j);
+                multiply(result.data(), result.data(), result.data());
+            }
+            multiply(result.data(), result.data(), table[value >> 1].data());
+            i = low;
+        }
+        return result;
+    }
+
+} // namespace BigNumberNamespace::LimbArithmetic
+
+#endif // LIMBARITHMETIC_HPP
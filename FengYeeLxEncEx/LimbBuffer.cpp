@@ -0,0 +1,63 @@
+#include "LimbBuffer.h"
+#include <utility>
+
+namespace BigNumberNamespace {
+
+    LimbBuffer::LimbBuffer(const LimbBuffer &Other) : LimbBuffer(Other.begin(), Other.end()) {}
+
+    LimbBuffer::LimbBuffer(LimbBuffer &&Other) noexcept: LimbBuffer() { *this = std::move(Other); }
+
+    LimbBuffer &LimbBuffer::operator=(const LimbBuffer &Other) {
+        if (this != &Other) {
+            reserve(Other.Size);
+            std::copy(Other.begin(), Other.end(), Data);
+            Size = Other.Size;
+        }
+        return *this;
+    }
+
+    LimbBuffer &LimbBuffer::operator=(LimbBuffer &&Other) noexcept {
+        if (this == &Other) { return *this; }
+        if (Other.isInline()) {
+            // Inline limbs cannot be stolen; keep our own heap block if we have one.
+            std::copy(Other.begin(), Other.end(), Data);
+            Size = Other.Size;
+        } else {
+            release();
+            Data = Other.Data;
+            Size = Other.Size;
+            Capacity = Other.Capacity;
+            Other.Data = Other.Inline;
+            Other.Capacity = InlineCapacity;
+        }
+        Other.Size = 0;
+        return *this;
+    }
+
+    LimbBuffer::~LimbBuffer() { release(); }
+
+    void LimbBuffer::grow(size_t MinimumCapacity) {
+        size_t newCapacity = std::max(MinimumCapacity, Capacity * 2);
+        auto *newData = new uint64_t[newCapacity];
+        std::copy(Data, Data + Size, newData);
+        release();
+        Data = newData;
+        Capacity = newCapacity;
+    }
+
+    void LimbBuffer::shrink_to_fit() {
+        if (isInline() || Size == Capacity) { return; }
+        uint64_t *newData = Size <= InlineCapacity ? Inline : new uint64_t[Size];
+        std::copy(Data, Data + Size, newData);
+        release();
+        Data = newData;
+        Capacity = std::max(Size, InlineCapacity);
+    }
+
+    void LimbBuffer::release() {
+        if (!isInline()) { delete[] Data; }
+        Data = Inline;
+        Capacity = InlineCapacity;
+    }
+
+} // namespace BigNumberNamespace
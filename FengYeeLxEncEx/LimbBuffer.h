@@ -0,0 +1,118 @@
+// LimbBuffer.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef LIMBBUFFER_HPP
+#define LIMBBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+namespace BigNumberNamespace {
+
+    // Growable limb array with room for InlineCapacity limbs inside the object.
+    // Values up to 256 bits never touch the heap; longer values move to a heap
+    // block that is reused as the buffer shrinks and grows again.
+    class LimbBuffer {
+    public:
+        static constexpr size_t InlineCapacity = 4;
+
+        LimbBuffer() noexcept: Data(Inline), Size(0), Capacity(InlineCapacity) {}
+
+        explicit LimbBuffer(size_t Count, uint64_t Value = 0) : LimbBuffer() { resize(Count, Value); }
+
+        LimbBuffer(std::initializer_list<uint64_t> Values) : LimbBuffer(Values.begin(), Values.end()) {}
+
+        // Single-pass iterators cannot be measured up front, so they grow the buffer as they go.
+        template<std::input_iterator Iterator>
+        LimbBuffer(Iterator First, Iterator Last) : LimbBuffer() {
+            if constexpr (std::forward_iterator<Iterator>) {
+                reserve(static_cast<size_t>(std::distance(First, Last)));
+                for (; First != Last; ++First) { Data[Size++] = *First; }
+            } else {
+                for (; First != Last; ++First) { push_back(*First); }
+            }
+        }
+
+        LimbBuffer(const LimbBuffer &Other);
+
+        LimbBuffer(LimbBuffer &&Other) noexcept;
+
+        LimbBuffer &operator=(const LimbBuffer &Other);
+
+        LimbBuffer &operator=(LimbBuffer &&Other) noexcept;
+
+        ~LimbBuffer();
+
+        [[nodiscard]] size_t size() const { return Size; }
+
+        [[nodiscard]] bool empty() const { return Size == 0; }
+
+        [[nodiscard]] size_t capacity() const { return Capacity; }
+
+        [[nodiscard]] bool isInline() const { return Data == Inline; }
+
+        uint64_t *data() { return Data; }
+
+        [[nodiscard]] const uint64_t *data() const { return Data; }
+
+        uint64_t *begin() { return Data; }
+
+        uint64_t *end() { return Data + Size; }
+
+        [[nodiscard]] const uint64_t *begin() const { return Data; }
+
+        [[nodiscard]] const uint64_t *end() const { return Data + Size; }
+
+        uint64_t &operator[](size_t Index) { return Data[Index]; }
+
+        const uint64_t &operator[](size_t Index) const { return Data[Index]; }
+
+        uint64_t &back() { return Data[Size - 1]; }
+
+        [[nodiscard]] const uint64_t &back() const { return Data[Size - 1]; }
+
+        void push_back(uint64_t Value) {
+            if (Size == Capacity) { grow(Size + 1); }
+            Data[Size++] = Value;
+        }
+
+        void pop_back() { --Size; }
+
+        void clear() { Size = 0; }
+
+        void reserve(size_t Count) {
+            if (Count > Capacity) { grow(Count); }
+        }
+
+        // Moves the contents back inline when they fit, otherwise into a heap
+        // block of exactly size() limbs.
+        void shrink_to_fit();
+
+        void resize(size_t Count, uint64_t Value = 0) {
+            reserve(Count);
+            if (Count > Size) { std::fill(Data + Size, Data + Count, Value); }
+            Size = Count;
+        }
+
+        friend bool operator==(const LimbBuffer &Left, const LimbBuffer &Right) {
+            return Left.Size == Right.Size && std::equal(Left.begin(), Left.end(), Right.begin());
+        }
+
+    private:
+        uint64_t *Data;
+        size_t Size;
+        size_t Capacity;
+        uint64_t Inline[InlineCapacity];
+
+        void grow(size_t MinimumCapacity);
+
+        void release();
+
+    };
+
+} // namespace BigNumberNamespace
+
+#endif // LIMBBUFFER_HPP
@@ -0,0 +1,65 @@
+#include "MontgomeryContext.h"
+#include "LimbArithmetic.h"
+#include <stdexcept>
+
+namespace BigNumberNamespace {
+
+    MontgomeryContext::MontgomeryContext(const BigNumber &Modulus)
+            : Modulus(Modulus.Limbs.begin(), Modulus.Limbs.end()) {
+        if (Modulus.Negative || this->Modulus.empty() || (this->Modulus[0] & 1) == 0) {
+            throw std::invalid_argument("Invalid modulus: Montgomery arithmetic needs a positive odd modulus.");
+        }
+        size_t n = this->Modulus.size();
+        NegInverse = LimbArithmetic::negativeInverse(this->Modulus[0]);
+
+        // R = 2^(64n); R mod m and R^2 mod m come from one division each.
+        std::vector<uint64_t> power(2 * n + 1, 0);
+        power[2 * n] = 1;
+        RSquared.resize(n);
+        LimbArithmetic::divide(nullptr, RSquared.data(), power.data(), 2 * n + 1, this->Modulus.data(), n);
+        ROne.resize(n);
+        LimbArithmetic::divide(nullptr, ROne.data(), power.data() + n, n + 1, this->Modulus.data(), n);
+    }
+
+    size_t MontgomeryContext::LimbCount() const { return Modulus.size(); }
+
+    std::vector<uint64_t> MontgomeryContext::One() const { return ROne; }
+
+    void MontgomeryContext::Multiply(uint64_t *r, const uint64_t *a, const uint64_t *b, uint64_t *scratch) const {
+        LimbArithmetic::montgomeryMultiply(r, a, b, Modulus.data(), Modulus.size(), NegInverse, scratch);
+    }
+
+    std::vector<uint64_t> MontgomeryContext::ToMontgomery(const BigNumber &Value) const {
+        BigNumber modulus(false, BigNumber::LimbVector(Modulus.begin(), Modulus.end()));
+        BigNumber reduced = Value.DivMod(modulus, DivisionMode::Floored).second;
+        std::vector<uint64_t> residue(Modulus.size(), 0);
+        std::copy(reduced.Limbs.begin(), reduced.Limbs.end(), residue.begin());
+
+        std::vector<uint64_t> scratch(Modulus.size() + 2);
+        Multiply(residue.data(), residue.data(), RSquared.data(), scratch.data());
+        return residue;
+    }
+
+    BigNumber MontgomeryContext::FromMontgomery(const std::vector<uint64_t> &Residue) const {
+        std::vector<uint64_t> one(Modulus.size(), 0);
+        one[0] = 1;
+        BigNumber::LimbVector result(Modulus.size());
+        std::vector<uint64_t> scratch(Modulus.size() + 2);
+        Multiply(result.data(), Residue.data(), one.data(), scratch.data());
+        return {false, std::move(result)};
+    }
+
+    BigNumber MontgomeryContext::Pow(const BigNumber &Base, const BigNumber &Exponent) const {
+        if (Exponent.Negative) {
+            throw std::invalid_argument("Invalid exponent: ModPow needs a non-negative exponent.");
+        }
+        std::vector<uint64_t> scratch(Modulus.size() + 2);
+        std::vector<uint64_t> result = LimbArithmetic::slidingWindowPow(
+                ToMontgomery(Base), Exponent.Limbs.data(), Exponent.Limbs.size(), One(),
+                [this, &scratch](uint64_t *r, const uint64_t *a, const uint64_t *b) {
+                    Multiply(r, a, b, scratch.data());
+                });
+        return FromMontgomery(result);
+    }
+
+} // namespace BigNumberNamespace
@@ -0,0 +1,45 @@
+// MontgomeryContext.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef MONTGOMERYCONTEXT_HPP
+#define MONTGOMERYCONTEXT_HPP
+
+#include "BigNumber.h"
+#include <cstdint>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    // Precomputed constants for Montgomery arithmetic modulo one odd modulus.
+    // Residues are fixed-width limb vectors holding x * 2^(64n) mod m, where n
+    // is LimbCount(). A context is immutable after construction and can be
+    // shared across threads.
+    class MontgomeryContext {
+    public:
+        explicit MontgomeryContext(const BigNumber &Modulus);
+
+        [[nodiscard]] BigNumber Pow(const BigNumber &Base, const BigNumber &Exponent) const;
+
+        [[nodiscard]] size_t LimbCount() const;
+
+        [[nodiscard]] std::vector<uint64_t> ToMontgomery(const BigNumber &Value) const;
+
+        [[nodiscard]] BigNumber FromMontgomery(const std::vector<uint64_t> &Residue) const;
+
+        [[nodiscard]] std::vector<uint64_t> One() const;
+
+        // r = a * b in Montgomery form; r may alias a or b. The scratch needs
+        // LimbCount() + 2 limbs.
+        void Multiply(uint64_t *r, const uint64_t *a, const uint64_t *b, uint64_t *scratch) const;
+
+    private:
+        std::vector<uint64_t> Modulus;
+        uint64_t NegInverse;
+        std::vector<uint64_t> RSquared;
+        std::vector<uint64_t> ROne;
+
+    };
+
+} // namespace BigNumberNamespace
+
+#endif // MONTGOMERYCONTEXT_HPP
@@ -0,0 +1,180 @@
+#include "MultiExp.h"
+#include "MontgomeryContext.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    namespace {
+        constexpr size_t MaxStrausWindow = 8;
+        constexpr size_t MaxPippengerWindow = 16;
+
+        size_t bitLength(std::span<const uint64_t> magnitude) {
+            if (magnitude.empty()) { return 0; }
+            return 64 * magnitude.size() - static_cast<size_t>(std::countl_zero(magnitude.back()));
+        }
+
+        // Bits [Low, Low + Width) of Exponent, Width <= 16.
+        size_t digitAt(std::span<const uint64_t> exponent, size_t Low, size_t Width) {
+            size_t limb = Low / 64;
+            if (limb >= exponent.size()) { return 0; }
+            size_t shift = Low % 64;
+            uint64_t bits = exponent[limb] >> shift;
+            if (shift + Width > 64 && limb + 1 < exponent.size()) { bits |= exponent[limb + 1] << (64 - shift); }
+            return static_cast<size_t>(bits & ((uint64_t{1} << Width) - 1));
+        }
+
+        // Accumulates Montgomery products into a residue that starts out as the
+        // identity, without spending a multiplication on the first factor.
+        class Accumulator {
+        public:
+            Accumulator(const MontgomeryContext &Context, uint64_t *Scratch)
+                    : Context(Context), Scratch(Scratch), Value(Context.LimbCount()) {}
+
+            void multiply(const uint64_t *Factor) {
+                if (Started) { Context.Multiply(Value.data(), Value.data(), Factor, Scratch); }
+                else { std::copy(Factor, Factor + Value.size(), Value.begin()); }
+                Started = true;
+            }
+
+            void square() {
+                if (Started) { Context.Multiply(Value.data(), Value.data(), Value.data(), Scratch); }
+            }
+
+            void reset() { Started = false; }
+
+            [[nodiscard]] bool started() const { return Started; }
+
+            [[nodiscard]] const uint64_t *data() const { return Value.data(); }
+
+            [[nodiscard]] std::vector<uint64_t> result() const { return Started ? Value : Context.One(); }
+
+        private:
+            const MontgomeryContext &Context;
+            uint64_t *Scratch;
+            std::vector<uint64_t> Value;
+            bool Started = false;
+        };
+
+        // Table[i][d] = Bases[i]^d for d in [1, 2^Window); one pass of Window
+        // shared squarings per digit position.
+        std::vector<uint64_t> straus(const MontgomeryContext &context, const std::vector<std::vector<uint64_t>> &bases,
+                                     std::span<const BigNumber> exponents, size_t bits, size_t window) {
+            size_t n = context.LimbCount();
+            size_t entries = size_t{1} << window;
+            std::vector<uint64_t> scratch(n + 2);
+            std::vector<uint64_t> table(bases.size() * entries * n);
+            for (size_t i = 0; i < bases.size(); ++i) {
+                uint64_t *row = table.data() + i * entries * n;
+                std::copy(bases[i].begin(), bases[i].end(), row + n);
+                for (size_t d = 2; d < entries; ++d) {
+                    context.Multiply(row + d * n, row + (d - 1) * n, bases[i].data(), scratch.data());
+                }
+            }
+
+            Accumulator result(context, scratch.data());
+            for (size_t position = (bits + window - 1) / window; position-- > 0;) {
+                for (size_t s = 0; s < window; ++s) { result.square(); }
+                for (size_t i = 0; i < bases.size(); ++i) {
+                    size_t digit = digitAt(exponents[i].Magnitude(), position * window, window);
+                    if (digit) { result.multiply(table.data() + (i * entries + digit) * n); }
+                }
+            }
+            return result.result();
+        }
+
+        // Per window of Window bits, bucket[d] collects every base whose digit
+        // is d; prod bucket[d]^d then comes from a suffix product and its
+        // running product in 2^(Window+1) multiplications.
+        std::vector<uint64_t> pippenger(const MontgomeryContext &context,
+                                        const std::vector<std::vector<uint64_t>> &bases,
+                                        std::span<const BigNumber> exponents, size_t bits, size_t window) {
+            size_t n = context.LimbCount();
+            size_t entries = size_t{1} << window;
+            std::vector<uint64_t> scratch(n + 2);
+            std::vector<uint64_t> buckets(entries * n);
+            std::vector<bool> filled(entries);
+
+            Accumulator result(context, scratch.data());
+            Accumulator suffix(context, scratch.data());
+            Accumulator windowProduct(context, scratch.data());
+            for (size_t position = (bits + window - 1) / window; position-- > 0;) {
+                for (size_t s = 0; s < window; ++s) { result.square(); }
+                std::fill(filled.begin(), filled.end(), false);
+                for (size_t i = 0; i < bases.size(); ++i) {
+                    size_t digit = digitAt(exponents[i].Magnitude(), position * window, window);
+                    if (!digit) { continue; }
+                    uint64_t *bucket = buckets.data() + digit * n;
+                    if (filled[digit]) { context.Multiply(bucket, bucket, bases[i].data(), scratch.data()); }
+                    else { std::copy(bases[i].begin(), bases[i].end(), bucket); }
+                    filled[digit] = true;
+                }
+
+                suffix.reset();
+                windowProduct.reset();
+                for (size_t d = entries; d-- > 1;) {
+                    if (filled[d]) { suffix.multiply(buckets.data() + d * n); }
+                    if (suffix.started()) { windowProduct.multiply(suffix.data()); }
+                }
+                if (windowProduct.started()) { result.multiply(windowProduct.data()); }
+            }
+            return result.result();
+        }
+    }
+
+    BigNumber MultiExp(std::span<const BigNumber> Bases, std::span<const BigNumber> Exponents,
+                       const BigNumber &Modulus) {
+        if (Bases.size() != Exponents.size()) {
+            throw std::invalid_argument("Invalid input: MultiExp needs one exponent per base.");
+        }
+        if (Modulus.IsNegative() || Modulus.IsZero()) {
+            throw std::invalid_argument("Invalid modulus: MultiExp needs a positive modulus.");
+        }
+        size_t bits = 0;
+        for (const BigNumber &exponent: Exponents) {
+            if (exponent.IsNegative()) {
+                throw std::invalid_argument("Invalid exponent: MultiExp needs non-negative exponents.");
+            }
+            bits = std::max(bits, bitLength(exponent.Magnitude()));
+        }
+
+        if ((Modulus.Magnitude()[0] & 1) == 0) {
+            BigNumber result = BigNumber(1) % Modulus;
+            for (size_t i = 0; i < Bases.size(); ++i) {
+                result = result * Bases[i].ModPow(Exponents[i], Modulus) % Modulus;
+            }
+            return result;
+        }
+
+        MontgomeryContext context(Modulus);
+        std::vector<std::vector<uint64_t>> bases;
+        bases.reserve(Bases.size());
+        for (const BigNumber &base: Bases) { bases.push_back(context.ToMontgomery(base)); }
+
+        // Multiplications besides the shared squarings: Straus builds 2^w - 2
+        // table entries per base and multiplies once per nonzero digit;
+        // Pippenger does one bucket insert per digit plus 2^(c+1) per window.
+        size_t k = Bases.size();
+        size_t strausWindow = 1;
+        size_t pippengerWindow = 1;
+        size_t strausCost = k * bits;
+        size_t pippengerCost = bits * (k + 4);
+        for (size_t w = 2; w <= MaxStrausWindow; ++w) {
+            size_t cost = k * ((size_t{1} << w) - 2 + bits / w);
+            if (cost < strausCost) { strausCost = cost; strausWindow = w; }
+        }
+        for (size_t c = 2; c <= MaxPippengerWindow; ++c) {
+            size_t cost = (bits + c - 1) / c * (k + (size_t{2} << c));
+            if (cost < pippengerCost) { pippengerCost = cost; pippengerWindow = c; }
+        }
+
+        std::vector<uint64_t> result = strausCost <= pippengerCost
+                                       ? straus(context, bases, Exponents, bits, strausWindow)
+                                       : pippenger(context, bases, Exponents, bits, pippengerWindow);
+        return context.FromMontgomery(result);
+    }
+
+} // namespace BigNumberNamespace
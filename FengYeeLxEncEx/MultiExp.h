@@ -0,0 +1,26 @@
+// MultiExp.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef MULTIEXP_HPP
+#define MULTIEXP_HPP
+
+#include "BigNumber.h"
+#include <span>
+
+namespace BigNumberNamespace {
+
+    // prod Bases[i]^Exponents[i] mod Modulus in [0, Modulus), sharing one run
+    // of squarings across all terms. Odd moduli work in Montgomery form and
+    // pick, by multiplication count, between Straus interleaving (a fixed
+    // window table per base; best for a handful of bases) and Pippenger
+    // bucketing (per window, bases are dropped into 2^c buckets by digit and
+    // the buckets are combined with two running products; best for hundreds
+    // of bases and more). Even moduli multiply separate ModPow results.
+    // Throws std::invalid_argument for mismatched spans, a non-positive
+    // modulus or a negative exponent.
+    BigNumber MultiExp(std::span<const BigNumber> Bases, std::span<const BigNumber> Exponents,
+                       const BigNumber &Modulus);
+
+} // namespace BigNumberNamespace
+
+#endif // MULTIEXP_HPP
@@ -0,0 +1,159 @@
+#include "Primality.h"
+#include "LimbArithmetic.h"
+#include "MontgomeryContext.h"
+#include <algorithm>
+#include <bit>
+#include <random>
+
+namespace BigNumberNamespace::Primality {
+
+    namespace {
+        __extension__ typedef unsigned __int128 uint128_t;
+
+        struct PrimeGroup {
+            uint64_t Product;
+            size_t First;
+            size_t Last;
+        };
+
+        struct SmallPrimeTable {
+            std::vector<uint32_t> Primes;
+            std::vector<PrimeGroup> Groups;
+        };
+
+        const SmallPrimeTable &smallPrimeTable() {
+            static const SmallPrimeTable table = [] {
+                SmallPrimeTable result;
+                std::vector<bool> composite(TrialDivisionLimit, false);
+                for (uint32_t i = 3; i < TrialDivisionLimit; i += 2) {
+                    if (composite[i]) { continue; }
+                    result.Primes.push_back(i);
+                    for (uint64_t j = static_cast<uint64_t>(i) * i; j < TrialDivisionLimit; j += 2 * i) {
+                        composite[j] = true;
+                    }
+                }
+                for (size_t i = 0; i < result.Primes.size();) {
+                    PrimeGroup group{1, i, i};
+                    while (group.Last < result.Primes.size() &&
+                           group.Product <= ~uint64_t{0} / result.Primes[group.Last]) {
+                        group.Product *= result.Primes[group.Last++];
+                    }
+                    result.Groups.push_back(group);
+                    i = group.Last;
+                }
+                return result;
+            }();
+            return table;
+        }
+
+        uint64_t powMod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+            uint64_t result = 1;
+            base %= modulus;
+            while (exponent) {
+                if (exponent & 1) { result = static_cast<uint64_t>(static_cast<uint128_t>(result) * base % modulus); }
+                base = static_cast<uint64_t>(static_cast<uint128_t>(base) * base % modulus);
+                exponent >>= 1;
+            }
+            return result;
+        }
+
+        // Random bases come from a per-thread generator so concurrent tests never share state.
+        std::mt19937_64 &baseGenerator() {
+            thread_local std::mt19937_64 generator{std::random_device{}()};
+            return generator;
+        }
+    }
+
+    const std::vector<uint32_t> &smallPrimes() { return smallPrimeTable().Primes; }
+
+    bool hasSmallFactor(std::span<const uint64_t> n) {
+        const SmallPrimeTable &table = smallPrimeTable();
+        for (const PrimeGroup &group: table.Groups) {
+            uint64_t remainder = LimbArithmetic::divideSingle(nullptr, n.data(), n.size(), group.Product);
+            for (size_t i = group.First; i < group.Last; ++i) {
+                if (remainder % table.Primes[i] == 0) { return true; }
+            }
+        }
+        return false;
+    }
+
+    void smallPrimeResidues(std::span<const uint64_t> n, uint32_t *residues) {
+        const SmallPrimeTable &table = smallPrimeTable();
+        for (const PrimeGroup &group: table.Groups) {
+            uint64_t remainder = LimbArithmetic::divideSingle(nullptr, n.data(), n.size(), group.Product);
+            for (size_t i = group.First; i < group.Last; ++i) {
+                residues[i] = static_cast<uint32_t>(remainder % table.Primes[i]);
+            }
+        }
+    }
+
+    bool isPrime64(uint64_t n) {
+        if (n < 2) { return false; }
+        if (n % 2 == 0) { return n == 2; }
+        const std::vector<uint32_t> &primes = smallPrimes();
+        if (n < TrialDivisionLimit) { return std::binary_search(primes.begin(), primes.end(), n); }
+        for (uint32_t p: primes) {
+            if (static_cast<uint64_t>(p) * p > n) { return true; }
+            if (n % p == 0) { return false; }
+            if (p > 64) { break; }
+        }
+
+        // These seven bases decide every n below 2^64.
+        uint64_t d = n - 1;
+        int s = std::countr_zero(d);
+        d >>= s;
+        for (uint64_t base: {2ULL, 325ULL, 9375ULL, 28178ULL, 450775ULL, 9780504ULL, 1795265022ULL}) {
+            uint64_t x = powMod(base, d, n);
+            if (x == 0 || x == 1 || x == n - 1) { continue; }
+            bool witness = true;
+            for (int i = 1; i < s && witness; ++i) {
+                x = static_cast<uint64_t>(static_cast<uint128_t>(x) * x % n);
+                if (x == n - 1) { witness = false; }
+            }
+            if (witness) { return false; }
+        }
+        return true;
+    }
+
+    bool millerRabin(const BigNumber &n, size_t Rounds) {
+        MontgomeryContext context(n);
+        std::span<const uint64_t> magnitude = n.Magnitude();
+
+        // n - 1 = d * 2^s with d odd.
+        std::vector<uint64_t> d(magnitude.begin(), magnitude.end());
+        d[0] -= 1;
+        size_t s = 0;
+        while (d[s / 64] == 0) { s += 64; }
+        s += static_cast<size_t>(std::countr_zero(d[s / 64]));
+        size_t limbShift = s / 64;
+        size_t bitShift = s % 64;
+        for (size_t i = 0; i + limbShift < d.size(); ++i) {
+            uint64_t high = i + limbShift + 1 < d.size() ? d[i + limbShift + 1] : 0;
+            d[i] = (d[i + limbShift] >> bitShift) | (bitShift ? high << (64 - bitShift) : 0);
+        }
+        d.resize(d.size() - limbShift);
+
+        std::vector<uint64_t> one = context.One();
+        std::vector<uint64_t> minusOne = context.ToMontgomery(n - 1);
+        std::vector<uint64_t> scratch(context.LimbCount() + 2);
+        auto multiply = [&context, &scratch](uint64_t *r, const uint64_t *a, const uint64_t *b) {
+            context.Multiply(r, a, b, scratch.data());
+        };
+
+        for (size_t round = 0; round < std::max<size_t>(Rounds, 1); ++round) {
+            BigNumber base(round == 0 ? uint64_t{2} : std::max<uint64_t>(baseGenerator()(), 2));
+            std::vector<uint64_t> x = LimbArithmetic::slidingWindowPow(context.ToMontgomery(base), d.data(), d.size(),
+                                                                       one, multiply);
+            if (x == one || x == minusOne) { continue; }
+            bool witness = true;
+            for (size_t i = 1; i < s && witness; ++i) {
+                multiply(x.data(), x.data(), x.data());
+                if (x == minusOne) { witness = false; }
+                else if (x == one) { break; }
+            }
+            if (witness) { return false; }
+        }
+        return true;
+    }
+
+} // namespace BigNumberNamespace::Primality
@@ -0,0 +1,38 @@
+// Primality.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef PRIMALITY_HPP
+#define PRIMALITY_HPP
+
+#include "BigNumber.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Probable-prime testing: a trial-division prefilter over the odd primes
+// below TrialDivisionLimit, then Miller-Rabin rounds in Montgomery form.
+namespace BigNumberNamespace::Primality {
+
+    constexpr uint32_t TrialDivisionLimit = 1 << 15;
+
+    // Odd primes below TrialDivisionLimit in increasing order, built once.
+    const std::vector<uint32_t> &smallPrimes();
+
+    // True if an odd prime below TrialDivisionLimit divides n. The primes are
+    // packed into groups whose product fits one limb, so each group costs a
+    // single pass of single-limb division over n.
+    bool hasSmallFactor(std::span<const uint64_t> n);
+
+    // residues[i] = n mod smallPrimes()[i], using the same grouped passes.
+    void smallPrimeResidues(std::span<const uint64_t> n, uint32_t *residues);
+
+    // Miller-Rabin on an odd n > 2^64: base 2, then Rounds - 1 random 64-bit bases.
+    bool millerRabin(const BigNumber &n, size_t Rounds);
+
+    // Deterministic test for any single-limb value.
+    bool isPrime64(uint64_t n);
+
+} // namespace BigNumberNamespace::Primality
+
+#endif // PRIMALITY_HPP
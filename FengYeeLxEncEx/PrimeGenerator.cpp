@@ -0,0 +1,111 @@
+#include "PrimeGenerator.h"
+#include "Primality.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace BigNumberNamespace {
+
+    namespace {
+        // Candidates start + 2k for k < SieveWindow are sieved together.
+        constexpr size_t SieveWindow = 4096;
+
+        // Below this many bits a candidate can itself be one of the sieving
+        // primes, so those sizes are drawn and tested directly.
+        constexpr size_t SmallPrimeBits = 16;
+
+        size_t bitLength(std::span<const uint64_t> magnitude) {
+            if (magnitude.empty()) { return 0; }
+            return 64 * magnitude.size() - static_cast<size_t>(std::countl_zero(magnitude.back()));
+        }
+    }
+
+    PrimeGenerator::PrimeGenerator(size_t Bits, size_t Rounds) : Bits(Bits), Rounds(Rounds) {
+        if (Bits < 2) {
+            throw std::invalid_argument("Invalid bit length: a prime needs at least 2 bits.");
+        }
+    }
+
+    BigNumber PrimeGenerator::Generate(size_t Threads) const {
+        if (Bits <= SmallPrimeBits) { return generateSmall(); }
+        if (Threads == 0) { Threads = std::max<size_t>(std::thread::hardware_concurrency(), 1); }
+
+        std::stop_source done;
+        std::optional<BigNumber> result;
+        {
+            std::vector<std::jthread> workers;
+            workers.reserve(Threads - 1);
+            for (size_t i = 1; i < Threads; ++i) {
+                workers.emplace_back([this, &done, &result] { search(done, result); });
+            }
+            search(done, result);
+        }
+        return std::move(*result);
+    }
+
+    BigNumber PrimeGenerator::randomStart(std::random_device &Device) const {
+        BigNumber::LimbVector limbs((Bits + 63) / 64);
+        for (uint64_t &limb: limbs) { limb = (static_cast<uint64_t>(Device()) << 32) | Device(); }
+        if (Bits % 64) { limbs.back() &= (uint64_t{1} << (Bits % 64)) - 1; }
+        limbs[(Bits - 1) / 64] |= uint64_t{1} << ((Bits - 1) % 64);
+        limbs[(Bits - 2) / 64] |= uint64_t{1} << ((Bits - 2) % 64);
+        limbs[0] |= 1;
+        return {false, std::move(limbs), BigNumber::NormalizedTag{}};
+    }
+
+    BigNumber PrimeGenerator::generateSmall() const {
+        std::random_device device;
+        for (;;) {
+            BigNumber candidate = randomStart(device);
+            if (Primality::isPrime64(candidate.Limbs[0])) { return candidate; }
+        }
+    }
+
+    void PrimeGenerator::search(std::stop_source &Done, std::optional<BigNumber> &Result) const {
+        std::random_device device;
+        const std::vector<uint32_t> &primes = Primality::smallPrimes();
+        std::vector<uint32_t> residues(primes.size());
+        std::vector<bool> composite(SieveWindow);
+
+        while (!Done.stop_requested()) {
+            BigNumber start = randomStart(device);
+            Primality::smallPrimeResidues(start.Magnitude(), residues.data());
+
+            for (bool inRange = true; inRange && !Done.stop_requested();) {
+                // start + 2k is divisible by p exactly when k = -start / 2 (mod p).
+                std::fill(composite.begin(), composite.end(), false);
+                for (size_t i = 0; i < primes.size(); ++i) {
+                    uint64_t p = primes[i];
+                    uint64_t k = (p - residues[i]) % p * ((p + 1) / 2) % p;
+                    for (; k < SieveWindow; k += p) { composite[k] = true; }
+                }
+
+                for (size_t k = 0; k < SieveWindow; ++k) {
+                    if (composite[k]) { continue; }
+                    if (Done.stop_requested()) { return; }
+                    BigNumber candidate = start + 2 * static_cast<uint64_t>(k);
+                    if (bitLength(candidate.Magnitude()) > Bits) {
+                        inRange = false;
+                        break;
+                    }
+                    bool prime = Bits <= 64 ? Primality::isPrime64(candidate.Limbs[0])
+                                            : Primality::millerRabin(candidate, Rounds);
+                    if (prime) {
+                        // Only the first request_stop() call succeeds, so exactly one worker
+                        // writes Result, and Generate reads it after every worker has joined.
+                        if (Done.request_stop()) { Result = std::move(candidate); }
+                        return;
+                    }
+                }
+
+                start += 2 * SieveWindow;
+                for (size_t i = 0; i < primes.size(); ++i) {
+                    residues[i] = static_cast<uint32_t>((residues[i] + 2 * SieveWindow) % primes[i]);
+                }
+            }
+        }
+    }
+
+} // namespace BigNumberNamespace
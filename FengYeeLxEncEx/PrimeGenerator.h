@@ -0,0 +1,44 @@
+// PrimeGenerator.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef PRIMEGENERATOR_HPP
+#define PRIMEGENERATOR_HPP
+
+#include "BigNumber.h"
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <stop_token>
+
+namespace BigNumberNamespace {
+
+    // Random probable primes of a fixed bit length with the top two bits set,
+    // so the product of two such primes has exactly twice as many bits.
+    // Each worker draws a random odd start and sieves the window of candidates
+    // start + 2k against the small-prime table, then advances the window by
+    // updating its residues instead of dividing again. Only sieve survivors
+    // reach Miller-Rabin, and the first worker to find a prime stops the rest.
+    class PrimeGenerator {
+    public:
+        // Throws std::invalid_argument when Bits < 2.
+        explicit PrimeGenerator(size_t Bits, size_t Rounds = 25);
+
+        // Threads == 0 uses one worker per hardware thread; the calling
+        // thread is one of the workers.
+        [[nodiscard]] BigNumber Generate(size_t Threads = 0) const;
+
+    private:
+        size_t Bits;
+        size_t Rounds;
+
+        [[nodiscard]] BigNumber randomStart(std::random_device &Device) const;
+
+        [[nodiscard]] BigNumber generateSmall() const;
+
+        void search(std::stop_source &Done, std::optional<BigNumber> &Result) const;
+
+    };
+
+} // namespace BigNumberNamespace
+
+#endif // PRIMEGENERATOR_HPP
@@ -0,0 +1,122 @@
+#include "Rsa.h"
+#include "MontgomeryContext.h"
+#include <bit>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace RsaNamespace {
+
+    using BigNumberNamespace::DivisionMode;
+    using BigNumberNamespace::MontgomeryContext;
+
+    namespace {
+        // Draws per prime before giving up on gcd(p - 1, e) = 1. For a prime e
+        // each draw fails with probability 1/(e - 1), at most 1/2.
+        constexpr size_t MaxPrimeAttempts = 64;
+
+        void checkRange(const BigNumber &Value, const BigNumber &Modulus) {
+            if (Value.IsNegative() || Value >= Modulus) {
+                throw std::invalid_argument("Invalid input: RSA operands must lie in [0, Modulus).");
+            }
+        }
+
+        BigNumber publicPow(const RsaPublicKey &Key, const BigNumber &Value) {
+            checkRange(Value, Key.Modulus);
+            if (Key.Exponent <= 0) {
+                throw std::invalid_argument("Invalid exponent: an RSA public exponent must be positive.");
+            }
+            std::span<const uint64_t> exponent = Key.Exponent.Magnitude();
+            if (exponent.size() != 1 || (Key.Modulus.Magnitude()[0] & 1) == 0) {
+                return Value.ModPow(Key.Exponent, Key.Modulus);
+            }
+
+            // Short public exponents: left-to-right binary, where a sliding-window
+            // table would cost more multiplications than it saves.
+            MontgomeryContext context(Key.Modulus);
+            std::vector<uint64_t> scratch(context.LimbCount() + 2);
+            std::vector<uint64_t> base = context.ToMontgomery(Value);
+            std::vector<uint64_t> result = base;
+            for (int bit = 62 - std::countl_zero(exponent[0]); bit >= 0; --bit) {
+                context.Multiply(result.data(), result.data(), result.data(), scratch.data());
+                if ((exponent[0] >> bit) & 1) {
+                    context.Multiply(result.data(), result.data(), base.data(), scratch.data());
+                }
+            }
+            return context.FromMontgomery(result);
+        }
+
+        // Garner: m = mq + q * (qInv * (mp - mq) mod p).
+        BigNumber recombine(const RsaPrivateKey &Key, const BigNumber &mp, BigNumber mq) {
+            BigNumber h = ((mp - mq) * Key.QInv).DivMod(Key.P, DivisionMode::Floored).second;
+            return std::move(mq) + h * Key.Q;
+        }
+
+        BigNumber privatePow(const RsaPrivateKey &Key, const BigNumber &Value, bool Concurrent) {
+            checkRange(Value, Key.Modulus);
+            auto halfP = [&Key, &Value] { return (Value % Key.P).ModPow(Key.Dp, Key.P); };
+            auto halfQ = [&Key, &Value] { return (Value % Key.Q).ModPow(Key.Dq, Key.Q); };
+            if (!Concurrent) { return recombine(Key, halfP(), halfQ()); }
+
+            // get() rethrows anything the second thread threw on this thread.
+            std::future<BigNumber> mq = std::async(std::launch::async, halfQ);
+            BigNumber mp = halfP();
+            return recombine(Key, mp, mq.get());
+        }
+
+        // A random prime of Bits bits with gcd(p - 1, PublicExponent) = 1.
+        BigNumber generateKeyPrime(size_t Bits, const BigNumber &PublicExponent, size_t Threads) {
+            for (size_t attempt = 0; attempt < MaxPrimeAttempts; ++attempt) {
+                BigNumber prime = BigNumber::GeneratePrime(Bits, Threads);
+                if ((prime - 1).Gcd(PublicExponent) == 1) { return prime; }
+            }
+            throw std::runtime_error("Key generation failed: no prime coprime to PublicExponent was found.");
+        }
+    }
+
+    RsaKeyPair GenerateKeyPair(size_t Bits, const BigNumber &PublicExponent, size_t Threads) {
+        if (Bits < 16) { throw std::invalid_argument("Invalid bit length: an RSA modulus needs at least 16 bits."); }
+        if (PublicExponent < 3 || PublicExponent % 2 == 0) {
+            throw std::invalid_argument("Invalid exponent: PublicExponent must be odd and at least 3.");
+        }
+        BigNumber p = generateKeyPrime(Bits - Bits / 2, PublicExponent, Threads);
+        BigNumber q = generateKeyPrime(Bits / 2, PublicExponent, Threads);
+        while (p == q) { q = generateKeyPrime(Bits / 2, PublicExponent, Threads); }
+        RsaPrivateKey key = MakePrivateKey(p, q, PublicExponent);
+        RsaPublicKey publicKey{key.Modulus, key.PublicExponent};
+        return {std::move(publicKey), std::move(key)};
+    }
+
+    RsaPrivateKey MakePrivateKey(const BigNumber &P, const BigNumber &Q, const BigNumber &PublicExponent) {
+        if (P == Q || P % 2 == 0 || Q % 2 == 0 || !P.IsProbablePrime() || !Q.IsProbablePrime()) {
+            throw std::invalid_argument("Invalid key: P and Q must be distinct odd primes.");
+        }
+        BigNumber pMinusOne = P - 1;
+        BigNumber qMinusOne = Q - 1;
+        std::optional<BigNumber> d = PublicExponent.ModInverse(pMinusOne.Lcm(qMinusOne));
+        std::optional<BigNumber> qInv = Q.ModInverse(P);
+        if (!d || !qInv) { throw std::invalid_argument("Invalid key: PublicExponent is not invertible."); }
+
+        BigNumber dp = *d % pMinusOne;
+        BigNumber dq = *d % qMinusOne;
+        return {P * Q, PublicExponent, std::move(*d), P, Q, std::move(dp), std::move(dq), std::move(*qInv)};
+    }
+
+    BigNumber Encrypt(const RsaPublicKey &Key, const BigNumber &Message) { return publicPow(Key, Message); }
+
+    bool Verify(const RsaPublicKey &Key, const BigNumber &Message, const BigNumber &Signature) {
+        if (Signature.IsNegative() || Signature >= Key.Modulus) { return false; }
+        return publicPow(Key, Signature) == Message;
+    }
+
+    BigNumber Decrypt(const RsaPrivateKey &Key, const BigNumber &Ciphertext, bool Concurrent) {
+        return privatePow(Key, Ciphertext, Concurrent);
+    }
+
+    BigNumber Sign(const RsaPrivateKey &Key, const BigNumber &Message, bool Concurrent) {
+        return privatePow(Key, Message, Concurrent);
+    }
+
+} // namespace RsaNamespace
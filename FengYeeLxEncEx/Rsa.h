@@ -0,0 +1,70 @@
+// Rsa.h
+// Created by FengYeeLx on 2024-11-02.
+
+#ifndef RSA_HPP
+#define RSA_HPP
+
+#include "BigNumber.h"
+#include <cstddef>
+
+// Raw (unpadded) RSA over BigNumber. Messages, ciphertexts and signatures are
+// integers in [0, Modulus); encoding and padding are left to the caller.
+namespace RsaNamespace {
+
+    using BigNumberNamespace::BigNumber;
+
+    struct RsaPublicKey {
+        BigNumber Modulus;
+        BigNumber Exponent;
+    };
+
+    // Keeps the CRT parameters Dp = D mod (P - 1), Dq = D mod (Q - 1) and
+    // QInv = Q^-1 mod P next to D, so private operations never touch D.
+    struct RsaPrivateKey {
+        BigNumber Modulus;
+        BigNumber PublicExponent;
+        BigNumber PrivateExponent;
+        BigNumber P;
+        BigNumber Q;
+        BigNumber Dp;
+        BigNumber Dq;
+        BigNumber QInv;
+    };
+
+    struct RsaKeyPair {
+        RsaPublicKey Public;
+        RsaPrivateKey Private;
+    };
+
+    // Two random primes of Bits / 2 bits each (via BigNumber::GeneratePrime on
+    // Threads threads), so the modulus has exactly Bits bits. Throws
+    // std::invalid_argument when Bits < 16 or PublicExponent is even or below 3.
+    RsaKeyPair GenerateKeyPair(size_t Bits, const BigNumber &PublicExponent = BigNumber("65537"), size_t Threads = 0);
+
+    // Derives D and the CRT parameters from the two primes; D is the inverse
+    // of PublicExponent mod lcm(P - 1, Q - 1). Throws std::invalid_argument
+    // when P and Q are not distinct odd primes (checked with IsProbablePrime)
+    // or PublicExponent is not invertible.
+    RsaPrivateKey MakePrivateKey(const BigNumber &P, const BigNumber &Q, const BigNumber &PublicExponent);
+
+    // Message^Exponent mod Modulus. Single-limb exponents such as 65537 use
+    // plain square-and-multiply in Montgomery form: 16 squarings and one
+    // multiplication, with no window table. Throws std::invalid_argument when
+    // Exponent is not positive or Message lies outside [0, Modulus).
+    BigNumber Encrypt(const RsaPublicKey &Key, const BigNumber &Message);
+
+    // True when Signature^Exponent mod Modulus equals Message. Throws like
+    // Encrypt on a non-positive Exponent.
+    bool Verify(const RsaPublicKey &Key, const BigNumber &Message, const BigNumber &Signature);
+
+    // Ciphertext^D mod Modulus through the CRT: two half-size exponentiations
+    // mod P and mod Q, recombined with Garner's formula. With Concurrent set
+    // the half mod Q runs on a second thread.
+    BigNumber Decrypt(const RsaPrivateKey &Key, const BigNumber &Ciphertext, bool Concurrent = false);
+
+    // Message^D mod Modulus, computed like Decrypt.
+    BigNumber Sign(const RsaPrivateKey &Key, const BigNumber &Message, bool Concurrent = false);
+
+} // namespace RsaNamespace
+
+#endif // RSA_HPP
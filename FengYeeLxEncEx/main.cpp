@@ -1,5 +1,12 @@
 #include <iostream>
+#include <vector>
+#include "BarrettReducer.h"
 #include "BigNumber.h"
+#include "BigNumberExpression.h"
+#include "FixedBaseExp.h"
+#include "LimbArithmetic.h"
+#include "MultiExp.h"
+#include "Rsa.h"
 
 using namespace BigNumberNamespace;
 
@@ -31,6 +38,31 @@ int main() {
         BigNumber diff2 = num2 - num1;
         std::cout << "Difference (reverse): " << diff2.ToString() << std::endl; // Expected: "-1"
 
+        // 测试向量化进位链
+        // B = 2^64 and both operands have n >= VectorCarryThreshold limbs, so the carry or borrow
+        // crosses every lane and 4-limb block; 17 and 19 leave odd tails. The expected values
+        // come from single-limb operations and multiplication, not the add/subtract kernels.
+        BigNumber limbBase("18446744073709551616");
+        bool carryChainsMatch = true;
+        std::string carrySum;
+        for (size_t limbs: {16, 17, 19}) {
+            BigNumber top(1);
+            for (size_t i = 1; i < limbs; ++i) { top = top * (uint64_t{1} << 32) * (uint64_t{1} << 32); }
+            BigNumber allOnes = top * limbBase - 1; // B^n - 1
+            BigNumber lowAndTop = top + 1;          // B^(n-1) + 1
+            BigNumber sumWithCarry = allOnes + lowAndTop;
+            if (limbs == 16) { carrySum = sumWithCarry.ToString(); }
+            BigNumber inPlace = top * 2;
+            inPlace -= lowAndTop;
+            carryChainsMatch = carryChainsMatch && sumWithCarry == top * (limbBase + 1) &&
+                               allOnes + allOnes == allOnes * 2 && top * 2 - lowAndTop == top - 1 &&
+                               inPlace == top - 1;
+        }
+        std::cout << "Carry chains match: " << carryChainsMatch << std::endl; // Expected: 1 (true)
+        std::cout << "B^16 - 1 + B^15 + 1: " << carrySum.size() << " digits ending "
+                  << carrySum.substr(carrySum.size() - 20)
+                  << std::endl; // Expected: "309 digits ending 17184919616138248192"
+
         // 测试乘法
         BigNumber prod1("123456789");
         BigNumber prod2("987654321");
@@ -61,6 +93,64 @@ int main() {
         BigNumber remainder2 = mod3 % mod2;
         std::cout << "Remainder with negative: " << remainder2.ToString() << std::endl; // Expected: "-1"
 
+        // 测试带余除法: (7, 2), (7, -2), (-7, 2), (-7, -2) 依次输出 商,余数
+        for (DivisionMode mode: {DivisionMode::Truncated, DivisionMode::Floored}) {
+            std::cout << (mode == DivisionMode::Truncated ? "DivMod truncated:" : "DivMod floored:");
+            for (const char *dividend: {"7", "-7"}) {
+                for (const char *divisor: {"2", "-2"}) {
+                    auto [q, r] = BigNumber(dividend).DivMod(BigNumber(divisor), mode);
+                    std::cout << " " << q.ToString() << "," << r.ToString();
+                }
+            }
+            std::cout << std::endl;
+        }
+        // Expected: "DivMod truncated: 3,1 -3,1 -3,-1 3,-1"
+        // Expected: "DivMod floored: 3,1 -4,-1 -4,1 3,-1"
+
+        auto [exactQuotient, exactRemainder] = div3.DivMod(div2, DivisionMode::Floored);
+        std::cout << "DivMod exact: " << exactQuotient.ToString() << "," << exactRemainder.ToString()
+                  << " " << exactRemainder.IsNegative() << std::endl; // Expected: "-987654321,0 0"
+
+        auto [floorQuotient, floorRemainder] = mod3.DivMod(mod2, DivisionMode::Floored);
+        std::cout << "DivMod floored multi-limb: " << floorQuotient.ToString() << "," << floorRemainder.ToString()
+                  << std::endl; // Expected: "-33333333333333333334,2"
+
+        // 测试多limb除数 (Knuth Algorithm D)
+        // u = {0, 0, 2^63, 2^63 - 1} and v = {1, 0, 2^63} in limbs: the estimate from the top limbs
+        // passes the two-limb test yet is one too large, so the add-back step runs.
+        BigNumber addBackDividend("57896044618658097708646941636650613544717097621216448811677614281724547563520");
+        BigNumber addBackDivisor("3138550867693340381917894711603833208051177722232017256449");
+        BigNumber addBackQuotient = addBackDividend / addBackDivisor;
+        BigNumber addBackRemainder = addBackDividend % addBackDivisor;
+        std::cout << "Add-back quotient: " << addBackQuotient.ToString()
+                  << std::endl; // Expected: "18446744073709551614"
+        std::cout << "Add-back remainder: " << addBackRemainder.ToString()
+                  << std::endl; // Expected: "3138550867693340381917894711603833208032730978158307704834"
+
+        bool longDivisionsMatch = addBackQuotient * addBackDivisor + addBackRemainder == addBackDividend &&
+                                  addBackRemainder >= 0 && addBackRemainder < addBackDivisor;
+        std::string dividendDigits(80, '0');
+        for (size_t i = 0; i < dividendDigits.size(); ++i) {
+            dividendDigits[i] = static_cast<char>('1' + (i * 7 + i / 5) % 9);
+        }
+        // 20 to 60 digits give divisors of two to four limbs.
+        for (size_t divisorLength: {20, 21, 39, 40, 58, 60}) {
+            for (const char *signs: {"++", "+-", "-+", "--"}) {
+                BigNumber dividend((signs[0] == '-' ? "-" : "") + dividendDigits);
+                BigNumber divisor((signs[1] == '-' ? "-" : "") + dividendDigits.substr(7, divisorLength));
+                BigNumber q = dividend / divisor;
+                BigNumber r = dividend % divisor;
+                longDivisionsMatch = longDivisionsMatch && q * divisor + r == dividend && r.Abs() < divisor.Abs() &&
+                                     (r == 0 || r.IsNegative() == dividend.IsNegative());
+            }
+        }
+        std::cout << "Multi-limb divisions match: " << longDivisionsMatch << std::endl; // Expected: 1 (true)
+
+        bool divModThrows = false;
+        try { (void) num1.DivMod(BigNumber("0")); }
+        catch (const std::invalid_argument &) { divModThrows = true; }
+        std::cout << "DivMod by zero throws: " << divModThrows << std::endl; // Expected: 1 (true)
+
         // 测试比较运算符
         BigNumber cmp1("100");
         BigNumber cmp2("200");
@@ -71,6 +161,234 @@ int main() {
         std::cout << "100 <= 200: " << (cmp1 <= cmp2) << std::endl; // Expected: 1 (true)
         std::cout << "200 >= 100: " << (cmp2 >= cmp1) << std::endl; // Expected: 1 (true)
 
+        // 测试大数乘法 (超过 NTT 阈值): (10^a - 1)(10^b - 1), a > b
+        // = 99...98 (b digits) 99...9 (a - b digits) 00...01 (b digits)
+        const size_t nttLongDigits = 100000;
+        const size_t nttShortDigits = 90000;
+        BigNumber nttLong(std::string(nttLongDigits, '9'));
+        BigNumber nttShort(std::string(nttShortDigits, '9'));
+        std::string productDigits = std::string(nttShortDigits - 1, '9') + "8" +
+                                    std::string(nttLongDigits - nttShortDigits, '9') +
+                                    std::string(nttShortDigits - 1, '0') + "1";
+        std::cout << "NTT product matches: " << ((nttLong * nttShort).ToString() == productDigits)
+                  << std::endl; // Expected: 1 (true)
+
+        // The same product through Toom-3: cut the shorter operand into chunks below the NTT
+        // threshold and combine the partial products by Horner's rule.
+        const size_t chunkDigits = LimbArithmetic::NttThreshold * 19 / 2;
+        std::string nttLeftDigits(4 * chunkDigits, '1');
+        std::string nttRightDigits(3 * chunkDigits, '1');
+        for (size_t i = 0; i < nttLeftDigits.size(); ++i) {
+            nttLeftDigits[i] = static_cast<char>('1' + (i * 7 + i / 11) % 9);
+            if (i < nttRightDigits.size()) { nttRightDigits[i] = static_cast<char>('1' + (i * 5 + i / 17) % 9); }
+        }
+        BigNumber nttLeft(nttLeftDigits);
+        BigNumber chunkBase("1" + std::string(chunkDigits, '0'));
+        BigNumber viaChunks("0");
+        for (size_t i = 0; i < 3; ++i) {
+            BigNumber chunk(nttRightDigits.substr(i * chunkDigits, chunkDigits));
+            viaChunks = viaChunks * chunkBase + nttLeft * chunk;
+        }
+        std::cout << "NTT matches chunked product: " << (nttLeft * BigNumber(nttRightDigits) == viaChunks)
+                  << std::endl; // Expected: 1 (true)
+
+        // 测试模幂
+        BigNumber base("4");
+        BigNumber exponent("13");
+        std::cout << "4^13 mod 497: " << base.ModPow(exponent, BigNumber("497")).ToString()
+                  << std::endl; // Expected: "445"
+        std::cout << "4^13 mod 500: " << base.ModPow(exponent, BigNumber("500")).ToString()
+                  << std::endl; // Expected: "364"
+
+        // 测试Barrett约减
+        BigNumber barrettModulus("100000000000000000000000000000000000000000000000151");
+        BarrettReducer reducer(barrettModulus);
+        BigNumber barrettValue = num1 * num2 * num1;
+        std::cout << "Barrett Reduce matches %: " << (reducer.Reduce(barrettValue) == barrettValue % barrettModulus)
+                  << std::endl; // Expected: 1 (true)
+        std::cout << "Barrett MulMod matches %: " << (reducer.MulMod(barrettValue, num2) ==
+                                                      barrettValue * num2 % barrettModulus)
+                  << std::endl; // Expected: 1 (true)
+
+        // 测试十进制转换 (跨越分治阈值)
+        bool roundTrips = true;
+        for (size_t digits: {759, 760, 761, 1521, 20000}) {
+            std::string dense(digits, '0');
+            for (size_t i = 0; i < digits; ++i) { dense[i] = static_cast<char>('0' + (i * 7 + i / 13) % 10); }
+            dense[0] = '9';
+            std::string sparse = "1" + std::string(digits - 2, '0') + "1";
+            roundTrips = roundTrips && BigNumber(dense).ToString() == dense &&
+                         BigNumber("-" + dense).ToString() == "-" + dense && BigNumber(sparse).ToString() == sparse;
+        }
+        std::cout << "Decimal round trips: " << roundTrips << std::endl; // Expected: 1 (true)
+        std::cout << "10^2000 formats: " << ((BigNumber(std::string(2000, '9')) + 1).ToString() ==
+                                             "1" + std::string(2000, '0')) << std::endl; // Expected: 1 (true)
+
+        // 测试十进制输入校验 (逐字检查)
+        bool lengthsParse = true;
+        std::string digitText = "1234567890123456789012345678901234567890";
+        BigNumber expectedValue("0");
+        for (size_t length = 1; length <= digitText.size(); ++length) {
+            expectedValue = expectedValue * 10 + (digitText[length - 1] - '0');
+            lengthsParse = lengthsParse && BigNumber(digitText.substr(0, length)) == expectedValue;
+        }
+        std::cout << "Lengths 1..40 parse: " << lengthsParse << std::endl; // Expected: 1 (true)
+
+        size_t rejected = 0;
+        for (size_t position = 0; position < 33; ++position) {
+            for (char bad: {'/', ':', ' '}) {
+                std::string text = digitText.substr(0, 33);
+                text[position] = bad;
+                try { (void) BigNumber(text); }
+                catch (const std::invalid_argument &) { ++rejected; }
+            }
+        }
+        std::cout << "Non-digits rejected: " << rejected << std::endl; // Expected: 99
+
+        size_t rejectedSigns = 0;
+        for (const char *text: {"-", "--1", "-x1", "+1", "1-"}) {
+            try { (void) BigNumber(text); }
+            catch (const std::invalid_argument &) { ++rejectedSigns; }
+        }
+        std::cout << "Bad signs rejected: " << rejectedSigns << std::endl; // Expected: 5
+        std::cout << "Negative parse: " << BigNumber("-1234567890123456789").ToString()
+                  << std::endl; // Expected: "-1234567890123456789"
+        std::cout << "Minus zero: " << BigNumber("-0").ToString() << " " << BigNumber("-0").IsNegative()
+                  << std::endl; // Expected: "0 0"
+
+        // 测试平方
+        std::cout << "Square: " << prod3.Square().ToString() << std::endl; // Expected: "15241578750190521"
+
+        // 1500, 5000 and 100000 digits reach the Karatsuba, Toom-3 and NTT squaring kernels.
+        bool squaresMatch = true;
+        for (size_t digits: {1500, 5000, 100000}) {
+            std::string text(digits, '0');
+            for (size_t i = 0; i < digits; ++i) { text[i] = static_cast<char>('0' + (i * 7 + i / 13) % 10); }
+            text[0] = '9';
+            BigNumber value(text);
+            BigNumber copy = value;
+            squaresMatch = squaresMatch && value.Square() == value * copy;
+        }
+        std::cout << "Square matches multiply: " << squaresMatch << std::endl; // Expected: 1 (true)
+
+        // 测试与原生整数运算
+        std::cout << "Plus int: " << (prod1 + 1).ToString() << std::endl; // Expected: "123456790"
+        std::cout << "Mod int: " << (prod3 % 97).ToString() << std::endl; // Expected: "-39"
+        std::cout << "Compare int: " << (prod3 < 0) << std::endl; // Expected: 1 (true)
+        std::cout << "From int: " << BigNumber(-42).ToString() << std::endl; // Expected: "-42"
+
+        // 测试最大公约数
+        BigNumber gcdLeft("462");
+        BigNumber gcdRight("1071");
+        ExtendedGcdResult bezout = gcdLeft.ExtendedGcd(gcdRight);
+        std::cout << "Gcd: " << gcdLeft.Gcd(gcdRight).ToString() << std::endl; // Expected: "21"
+        std::cout << "Lcm: " << gcdLeft.Lcm(gcdRight).ToString() << std::endl; // Expected: "23562"
+        std::cout << "Bezout: " << bezout.X.ToString() << " " << bezout.Y.ToString() << std::endl; // Expected: "7 -3"
+
+        // 测试模逆
+        std::optional<BigNumber> inverse = BigNumber("3").ModInverse(BigNumber("11"));
+        bool inverseExists = gcdLeft.ModInverse(gcdRight).has_value();
+        std::cout << "ModInverse: " << inverse->ToString() << std::endl; // Expected: "4"
+        std::cout << "ModInverse exists: " << inverseExists << std::endl; // Expected: 0 (false)
+
+        // An 80-digit modulus against a 25-digit value: their leading bits cannot predict a
+        // quotient, so the first step is a full division by a two-limb divisor.
+        BigNumber inverseModulus(dividendDigits + "1");
+        BigNumber inverseValue(dividendDigits.substr(3, 25));
+        std::optional<BigNumber> longInverse = inverseValue.ModInverse(inverseModulus);
+        ExtendedGcdResult longBezout = inverseModulus.ExtendedGcd(inverseValue);
+        std::cout << "Multi-limb ModInverse matches: "
+                  << (longInverse.has_value() && *longInverse * inverseValue % inverseModulus == 1 &&
+                      inverseModulus * longBezout.X + inverseValue * longBezout.Y ==
+                      inverseModulus.Gcd(inverseValue))
+                  << std::endl; // Expected: 1 (true)
+
+        // 测试素性
+        BigNumber mersenne127("170141183460469231731687303715884105727");
+        BigNumber carmichael("561");
+        std::cout << "IsProbablePrime: " << mersenne127.IsProbablePrime() << std::endl; // Expected: 1 (true)
+        std::cout << "IsProbablePrime: " << (mersenne127 * 3).IsProbablePrime() << std::endl; // Expected: 0 (false)
+        std::cout << "IsProbablePrime: " << carmichael.IsProbablePrime() << std::endl; // Expected: 0 (Carmichael)
+
+        // 测试素数生成
+        BigNumber generated = BigNumber::GeneratePrime(256);
+        std::cout << "GeneratePrime: " << generated.IsProbablePrime() << std::endl; // Expected: 1 (true)
+
+        // 测试RSA
+        RsaNamespace::RsaPrivateKey rsaKey =
+                RsaNamespace::MakePrivateKey(BigNumber("61"), BigNumber("53"), BigNumber("17"));
+        RsaNamespace::RsaPublicKey rsaPublic{rsaKey.Modulus, rsaKey.PublicExponent};
+        BigNumber message("65");
+        BigNumber cipher = RsaNamespace::Encrypt(rsaPublic, message);
+        BigNumber signature = RsaNamespace::Sign(rsaKey, message);
+        std::cout << "RSA encrypt: " << cipher.ToString() << std::endl; // Expected: "2790"
+        BigNumber decrypted = RsaNamespace::Decrypt(rsaKey, cipher, true);
+        std::cout << "RSA decrypt: " << decrypted.ToString() << std::endl; // Expected: "65"
+        std::cout << "RSA verify: " << RsaNamespace::Verify(rsaPublic, message, signature) << std::endl; // Expected: 1
+
+        // 生成的512位密钥: 串行与并发CRT各做一次加解密和签名验证
+        RsaNamespace::RsaKeyPair generatedKey = RsaNamespace::GenerateKeyPair(512, BigNumber("65537"), 2);
+        BigNumber generatedMessage("123456789012345678901234567890123456789");
+        BigNumber generatedCipher = RsaNamespace::Encrypt(generatedKey.Public, generatedMessage);
+        bool generatedRoundTrips = generatedCipher != generatedMessage;
+        for (bool concurrent: {false, true}) {
+            BigNumber generatedSignature = RsaNamespace::Sign(generatedKey.Private, generatedMessage, concurrent);
+            generatedRoundTrips = generatedRoundTrips &&
+                                  RsaNamespace::Decrypt(generatedKey.Private, generatedCipher, concurrent) ==
+                                  generatedMessage &&
+                                  RsaNamespace::Verify(generatedKey.Public, generatedMessage, generatedSignature) &&
+                                  !RsaNamespace::Verify(generatedKey.Public, generatedMessage + 1, generatedSignature);
+        }
+        std::cout << "RSA generated key round trips: " << generatedRoundTrips << std::endl; // Expected: 1 (true)
+
+        size_t rejectedExponents = 0;
+        for (const char *publicExponent: {"65536", "1"}) {
+            try { (void) RsaNamespace::GenerateKeyPair(64, BigNumber(publicExponent)); }
+            catch (const std::invalid_argument &) { ++rejectedExponents; }
+        }
+        std::cout << "RSA bad exponents rejected: " << rejectedExponents << std::endl; // Expected: 2
+
+        size_t rejectedPublicKeys = 0;
+        for (const char *publicExponent: {"-3", "0"}) {
+            RsaNamespace::RsaPublicKey badKey{rsaKey.Modulus, BigNumber(publicExponent)};
+            try { (void) RsaNamespace::Encrypt(badKey, message); }
+            catch (const std::invalid_argument &) { ++rejectedPublicKeys; }
+            try { (void) RsaNamespace::Verify(badKey, message, signature); }
+            catch (const std::invalid_argument &) { ++rejectedPublicKeys; }
+        }
+        std::cout << "RSA non-positive exponents rejected: " << rejectedPublicKeys << std::endl; // Expected: 4
+
+        size_t rejectedPrimes = 0;
+        for (auto [p, q]: {std::pair{"4", "53"}, std::pair{"61", "9"}, std::pair{"2", "53"}, std::pair{"61", "61"}}) {
+            try { (void) RsaNamespace::MakePrivateKey(BigNumber(p), BigNumber(q), BigNumber("17")); }
+            catch (const std::invalid_argument &) { ++rejectedPrimes; }
+        }
+        std::cout << "RSA bad primes rejected: " << rejectedPrimes << std::endl; // Expected: 4
+
+        // 测试固定底数模幂
+        FixedBaseExp fixedBase(base, BigNumber("497"), 16);
+        std::cout << "Fixed-base 4^13 mod 497: " << fixedBase.Pow(exponent).ToString()
+                  << std::endl; // Expected: "445"
+
+        // 20 bits over 4 teeth gives 5-bit rows; 4 requested tables round to 2-bit blocks and 3 tables.
+        FixedBaseExp roundedComb(BigNumber("7"), barrettModulus, 20, 4, 4);
+        bool combMatches = true;
+        for (uint64_t power: {0, 1, 2, 31, 1000, 524287, 1048575}) {
+            combMatches = combMatches && roundedComb.Pow(BigNumber(power)) ==
+                                         BigNumber("7").ModPow(BigNumber(power), barrettModulus);
+        }
+        std::cout << "Rounded comb matches ModPow: " << combMatches << std::endl; // Expected: 1 (true)
+
+        // 测试多重模幂
+        std::vector<BigNumber> multiBases{BigNumber("4"), BigNumber("3")};
+        std::vector<BigNumber> multiExponents{BigNumber("13"), BigNumber("5")};
+        std::cout << "4^13 * 3^5 mod 497: " << MultiExp(multiBases, multiExponents, BigNumber("497")).ToString()
+                  << std::endl; // Expected: "286"
+
+        // 测试融合表达式
+        BigNumber fused = (Lazy(prod1) * prod2 + num1) % BigNumber("1000000007");
+        std::cout << "Fused (a * b + c) % m: " << fused.ToString() << std::endl; // Expected: "259111759"
+
     } catch (const std::invalid_argument &e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }